@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>  // 为了使用 std::max
+#include <cstddef>    // 为了使用 std::size_t
+#include <cstdint>    // 为了使用 std::uintptr_t
+#include <new>        // 为了使用 ::operator new
+
+// 线性（bump）分配区：从成块申请的大空间中顺序切分，单个对象不单独释放，
+// 适用于同一批次内创建、随后一起丢弃的对象。reset() 一次回收全部空间，且保留已申请的块供下一批次复用。
+class Arena {
+private:
+    struct Block {
+        Block* next;       // 下一块
+        std::size_t size;  // 本块可用字节数（不含块头）
+        char* data() { return reinterpret_cast<char*>(this + 1); }
+    };
+
+    Block* _head;            // 首块
+    Block* _current;         // 当前正在切分的块
+    char* _top;              // 当前块中下一次分配的起点
+    char* _end;              // 当前块的末尾
+    std::size_t _blockSize;  // 默认块大小
+    long long _blocks;       // 累计向全局堆申请的块数
+
+    // 切换到 b 作为当前块
+    void use(Block* b) {
+        _current = b;
+        _top = b->data();
+        _end = _top + b->size;
+    }
+
+    // 在当前块之后接入一个至少 bytes 字节的块：优先复用 reset() 前留下的块，否则新申请
+    void advance(std::size_t bytes) {
+        Block* next = _current ? _current->next : _head;
+        if (next && next->size >= bytes) {
+            use(next);
+            return;
+        }
+        std::size_t size = std::max(bytes, _blockSize);
+        Block* b = static_cast<Block*>(::operator new(sizeof(Block) + size));
+        b->size = size;
+        b->next = next;
+        if (_current) _current->next = b;
+        else _head = b;
+        _blocks++;
+        use(b);
+    }
+
+public:
+    explicit Arena(std::size_t blockSize = 64 * 1024)
+        : _head(nullptr), _current(nullptr), _top(nullptr), _end(nullptr), _blockSize(blockSize), _blocks(0) {}
+
+    ~Arena() { release(); }
+
+    Arena(Arena const&) = delete;
+    Arena& operator=(Arena const&) = delete;
+
+    // 申请 bytes 字节、按 align 对齐的空间
+    void* allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t)) {
+        std::uintptr_t p = (reinterpret_cast<std::uintptr_t>(_top) + align - 1) & ~(std::uintptr_t)(align - 1);
+        if (!_current || p + bytes > reinterpret_cast<std::uintptr_t>(_end)) {
+            advance(bytes + align);
+            p = (reinterpret_cast<std::uintptr_t>(_top) + align - 1) & ~(std::uintptr_t)(align - 1);
+        }
+        _top = reinterpret_cast<char*>(p + bytes);
+        return reinterpret_cast<void*>(p);
+    }
+
+    // 归还空间：只有最近一次分配能被真正收回（例如用完即弃的临时缓冲区），其余留待 reset()。
+    // 向量扩容时先申请新数据区、迁移元素后才释放旧数据区，此时旧数据区已不在顶端，
+    // 故扩容留下的旧数据区不会被收回，直到 reset()
+    void deallocate(void* p, std::size_t bytes) {
+        if (static_cast<char*>(p) + bytes == _top) _top = static_cast<char*>(p);
+    }
+
+    // 回收全部空间，已申请的块保留复用；此前分配出的指针全部失效
+    void reset() {
+        if (_head) use(_head);
+    }
+
+    // 将全部块归还全局堆
+    void release() {
+        while (_head) {
+            Block* b = _head;
+            _head = b->next;
+            ::operator delete(b);
+        }
+        _current = nullptr;
+        _top = _end = nullptr;
+    }
+
+    long long blocks() const { return _blocks; }  // 累计申请的块数
+};
+
+// 基于 Arena 的分配器，可作为 Vector 的 Alloc 参数；deallocate() 基本为空操作，空间随 Arena::reset() 统一回收
+template <typename T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+
+    Arena* arena;
+
+    explicit ArenaAllocator(Arena& a) : arena(&a) {}
+    template <typename U>
+    ArenaAllocator(ArenaAllocator<U> const& other) : arena(other.arena) {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T* p, std::size_t n) { arena->deallocate(p, n * sizeof(T)); }
+};
+
+template <typename T, typename U>
+bool operator==(ArenaAllocator<T> const& a, ArenaAllocator<U> const& b) { return a.arena == b.arena; }
+
+template <typename T, typename U>
+bool operator!=(ArenaAllocator<T> const& a, ArenaAllocator<U> const& b) { return a.arena != b.arena; }
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cmath>
+#include <iostream>
+
+class Complex {
+public:
+    double real;  // 实部
+    double imag;  // 虚部
+
+    Complex(double r = 0.0, double i = 0.0) : real(r), imag(i) {}
+
+    // 计算复数的模
+    double modulus() const {
+        return std::sqrt(squaredModulus());
+    }
+
+    // 模的平方，无需开方
+    double squaredModulus() const {
+        return real * real + imag * imag;
+    }
+
+    // 重载相等运算符，用于查找
+    bool operator==(const Complex& other) const {
+        return real == other.real && imag == other.imag;
+    }
+
+    // 用于打印复数
+    void print() const {
+        std::cout << real << " + " << imag << "i";
+    }
+};
+
+// 模的平方的门限：返回最小的 s，使得 std::sqrt(s) >= m。
+// 于是对任何复数 c 都有 c.modulus() >= m 当且仅当 c.squaredModulus() >= modulusThreshold(m)，
+// 按模的区间筛选可以改为比较模的平方而不必逐个开方，且与逐个开方的结果完全一致
+inline double modulusThreshold(double m) {
+    if (m != m) return m;  // NaN：任何比较都不成立
+    if (m <= 0) return -INFINITY;  // 任何模都不小于 m
+    double s = m * m;
+    while (s > 0 && std::sqrt(std::nextafter(s, 0.0)) >= m) s = std::nextafter(s, 0.0);  // 舍入可能使 m * m 偏大或偏小，逐个调整
+    while (std::sqrt(s) < m) s = std::nextafter(s, INFINITY);
+    return s;
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cmath>   // 为了使用 std::sqrt
+#include <vector>  // 为了使用 std::vector
+
+#include "Complex.h"
+#include "VectorSimd.h"  // 为了使用 cpuHasAvx2(), AVX2_TARGET
+
+// 复数的列式存储：实部与虚部各占一个连续数组，成批计算模、查找与按模筛选时可以逐寄存器处理。
+// 各批量操作与逐个调用 Complex 的成员函数运算次序相同（模按 sqrt(re*re + im*im) 计算，开方为正确舍入），结果一致
+class ComplexColumns {
+private:
+    std::vector<double> _real;  // 实部
+    std::vector<double> _imag;  // 虚部
+
+    // 通用版本
+    void squaredModulusScalar(int lo, int hi, double* out) const {
+        for (int i = lo; i < hi; i++) out[i] = _real[i] * _real[i] + _imag[i] * _imag[i];
+    }
+    void modulusScalar(int lo, int hi, double* out) const {
+        for (int i = lo; i < hi; i++) out[i] = std::sqrt(_real[i] * _real[i] + _imag[i] * _imag[i]);
+    }
+    int findScalar(int lo, Complex const& e) const {
+        for (int i = lo; i < size(); i++)
+            if (_real[i] == e.real && _imag[i] == e.imag) return i;
+        return -1;
+    }
+    // t1、t2 为 modulusThreshold(m1)、modulusThreshold(m2)，比较模的平方即可，无需开方
+    void filterScalar(int lo, double t1, double t2, std::vector<int>& out) const {
+        for (int i = lo; i < size(); i++) {
+            double s = _real[i] * _real[i] + _imag[i] * _imag[i];
+            if (s >= t1 && s < t2) out.push_back(i);
+        }
+    }
+
+#ifdef VECTOR_SIMD_AVX2
+    // AVX2 版本：每次处理 4 个复数，尾部交给通用版本
+    AVX2_TARGET void squaredModulusAvx2(double* out, bool root) const {
+        double const* re = _real.data();
+        double const* im = _imag.data();
+        int n = size(), i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256d a = _mm256_loadu_pd(re + i), b = _mm256_loadu_pd(im + i);
+            __m256d s = _mm256_add_pd(_mm256_mul_pd(a, a), _mm256_mul_pd(b, b));
+            _mm256_storeu_pd(out + i, root ? _mm256_sqrt_pd(s) : s);
+        }
+        if (root) modulusScalar(i, n, out);
+        else squaredModulusScalar(i, n, out);
+    }
+
+    AVX2_TARGET int findAvx2(Complex const& e) const {
+        double const* re = _real.data();
+        double const* im = _imag.data();
+        __m256d r = _mm256_set1_pd(e.real), m = _mm256_set1_pd(e.imag);
+        int n = size(), i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256d eq = _mm256_and_pd(_mm256_cmp_pd(_mm256_loadu_pd(re + i), r, _CMP_EQ_OQ),
+                                       _mm256_cmp_pd(_mm256_loadu_pd(im + i), m, _CMP_EQ_OQ));
+            int mask = _mm256_movemask_pd(eq);
+            if (mask) return i + __builtin_ctz(mask);
+        }
+        return findScalar(i, e);
+    }
+
+    AVX2_TARGET void filterAvx2(double t1, double t2, std::vector<int>& out) const {
+        double const* re = _real.data();
+        double const* im = _imag.data();
+        __m256d lo = _mm256_set1_pd(t1), hi = _mm256_set1_pd(t2);
+        int n = size(), i = 0, k = 0;
+        out.resize(n + 4);  // 命中数不超过 n，多出的位置供无分支写入
+        int* p = out.data();
+        for (; i + 4 <= n; i += 4) {
+            __m256d a = _mm256_loadu_pd(re + i), b = _mm256_loadu_pd(im + i);
+            __m256d s = _mm256_add_pd(_mm256_mul_pd(a, a), _mm256_mul_pd(b, b));
+            int mask = _mm256_movemask_pd(_mm256_and_pd(_mm256_cmp_pd(s, lo, _CMP_GE_OQ), _mm256_cmp_pd(s, hi, _CMP_LT_OQ)));
+            for (int j = 0; j < 4; j++) {  // 无分支压缩：总是写入，命中时才前进
+                p[k] = i + j;
+                k += (mask >> j) & 1;
+            }
+        }
+        out.resize(k);
+        filterScalar(i, t1, t2, out);
+    }
+#endif
+
+public:
+    ComplexColumns() {}
+
+    // 由行式存储转换
+    explicit ComplexColumns(std::vector<Complex> const& vec) {
+        reserve((int)vec.size());
+        for (Complex const& c : vec) push_back(c);
+    }
+
+    int size() const { return (int)_real.size(); }
+
+    void reserve(int n) {
+        _real.reserve(n);
+        _imag.reserve(n);
+    }
+
+    void push_back(Complex const& c) {
+        _real.push_back(c.real);
+        _imag.push_back(c.imag);
+    }
+
+    Complex operator[](int i) const { return Complex(_real[i], _imag[i]); }
+
+    double const* real() const { return _real.data(); }
+    double const* imag() const { return _imag.data(); }
+
+    // 转换回行式存储
+    std::vector<Complex> toVector() const {
+        std::vector<Complex> vec;
+        vec.reserve(size());
+        for (int i = 0; i < size(); i++) vec.emplace_back(_real[i], _imag[i]);
+        return vec;
+    }
+
+    // 将各复数的模的平方写入 out[0, size())
+    void squaredModulus(double* out) const {
+#ifdef VECTOR_SIMD_AVX2
+        if (cpuHasAvx2()) return squaredModulusAvx2(out, false);
+#endif
+        squaredModulusScalar(0, size(), out);
+    }
+
+    // 将各复数的模写入 out[0, size())
+    void modulus(double* out) const {
+#ifdef VECTOR_SIMD_AVX2
+        if (cpuHasAvx2()) return squaredModulusAvx2(out, true);
+#endif
+        modulusScalar(0, size(), out);
+    }
+
+    // 首个等于 e 的复数的位置，没有时返回 -1
+    int find(Complex const& e) const {
+#ifdef VECTOR_SIMD_AVX2
+        if (cpuHasAvx2()) return findAvx2(e);
+#endif
+        return findScalar(0, e);
+    }
+
+    // 模落在 [m1, m2) 内的复数的位置，按原有次序排列
+    std::vector<int> filterByModulus(double m1, double m2) const {
+        std::vector<int> out;
+        double t1 = modulusThreshold(m1), t2 = modulusThreshold(m2);
+#ifdef VECTOR_SIMD_AVX2
+        if (cpuHasAvx2()) {
+            filterAvx2(t1, t2, out);
+            return out;
+        }
+#endif
+        filterScalar(0, t1, t2, out);
+        return out;
+    }
+
+    // 模落在 [m1, m2) 内的复数，与 findInRange() 的结果相同
+    std::vector<Complex> findInRange(double m1, double m2) const {
+        std::vector<int> hits = filterByModulus(m1, m2);
+        std::vector<Complex> result;
+        result.reserve(hits.size());
+        for (int i : hits) result.emplace_back(_real[i], _imag[i]);
+        return result;
+    }
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>  // 为了使用 std::size_t
+#include <cstdint>  // 为了使用 std::uintptr_t
+#include <new>      // 为了使用 ::operator new
+
+#include "Vector.cpp"
+
+#if defined(__GNUC__)
+#define EYTZINGER_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define EYTZINGER_PREFETCH(p) ((void)0)
+#endif
+
+// 有序向量的只读查找索引：按 Eytzinger（完全二叉树的层次遍历）次序重排元素，
+// 查找路径上的前几层集中在少数缓存行内，更深的层次可以提前预取，规模远超缓存时仍能保持较高的吞吐
+template <typename T>
+class EytzingerIndex {
+private:
+    static const int LINE = 64;                                          // 缓存行字节数
+    static const int BLOCK = sizeof(T) < LINE ? LINE / sizeof(T) : 1;    // 一个缓存行容纳的元素数
+    static const int BATCH = 16;                                         // search_many() 中交替推进的查询数
+
+    Rank _n;        // 元素个数
+    int _height;    // 树高（层数），满层为前 _height - 1 层
+    void* _raw;     // 原始空间，_key 由此按缓存行对齐
+    T* _key;        // _key[1, _n] 为层次次序的元素，_key[k] 的孩子为 _key[2k] 与 _key[2k + 1]
+    Rank* _rank;    // _rank[k] 为 _key[k] 在原有序向量中的秩
+
+    // 中序遍历以 k 为根的子树，依次填入有序向量中从 i 开始的元素，返回下一个待填入的秩
+    template <typename V>
+    Rank build(V const& A, Rank i, Rank k) {
+        if (k > _n) return i;
+        i = build(A, i, 2 * k);
+        new (_key + k) T(A[i]);
+        _rank[k] = i++;
+        return build(A, i, 2 * k + 1);
+    }
+
+    // 下行终止时 k 的二进制末尾若干个 1 代表最后几步右转，去掉它们及其上一个 0 即回到首个大于 e 的结点
+    static Rank unwind(Rank k) {
+        unsigned x = (unsigned)k;
+#if defined(__GNUC__)
+        return (Rank)(x >> (__builtin_ctz(~x) + 1));
+#else
+        while (x & 1) x >>= 1;
+        return (Rank)(x >> 1);
+#endif
+    }
+
+    // 首个大于 e 的结点对应的秩减一，即末个不大于 e 的元素的秩
+    Rank result(Rank k) const {
+        k = unwind(k);
+        return k ? _rank[k] - 1 : _n - 1;
+    }
+
+public:
+    // 由有序向量构造索引
+    template <typename Alloc>
+    explicit EytzingerIndex(Vector<T, Alloc> const& V) : _n(V.size()), _height(0) {
+        while ((1LL << _height) <= _n) _height++;
+        _raw = ::operator new((_n + 1) * sizeof(T) + LINE);
+        _key = reinterpret_cast<T*>((reinterpret_cast<std::uintptr_t>(_raw) + LINE - 1) & ~(std::uintptr_t)(LINE - 1));
+        _rank = new Rank[_n + 1];
+        build(V, 0, 1);
+    }
+
+    ~EytzingerIndex() {
+        for (Rank k = 1; k <= _n; k++) _key[k].~T();
+        ::operator delete(_raw);
+        delete[] _rank;
+    }
+
+    EytzingerIndex(EytzingerIndex const&) = delete;
+    EytzingerIndex& operator=(EytzingerIndex const&) = delete;
+
+    Rank size() const { return _n; }
+
+    // 查找：返回末个不大于 e 的元素在原有序向量中的秩，没有时返回 -1，与 Vector::search() 一致
+    Rank search(T const& e) const {
+        Rank k = 1;
+        for (int level = 1; level < _height; level++) {  // 满层无需判断越界
+            EYTZINGER_PREFETCH(_key + (std::size_t)BLOCK * k);  // 预取 log2(BLOCK) 层之后的后代，它们恰好占一个缓存行
+            k = 2 * k + !(e < _key[k]);
+        }
+        if (k <= _n) k = 2 * k + !(e < _key[k]);  // 末层可能不满
+        return result(k);
+    }
+
+    // 批量查找：每 BATCH 个查询为一组逐层交替推进，各查询的访存相互重叠；out[i] 为 queries[i] 的查找结果
+    void search_many(T const* queries, int m, Rank* out) const {
+        Rank k[BATCH];
+        for (int base = 0; base < m; base += BATCH) {
+            int g = m - base < BATCH ? m - base : BATCH;
+            T const* q = queries + base;
+            for (int j = 0; j < g; j++) k[j] = 1;
+            for (int level = 1; level < _height; level++)
+                for (int j = 0; j < g; j++) {
+                    EYTZINGER_PREFETCH(_key + (std::size_t)BLOCK * k[j]);
+                    k[j] = 2 * k[j] + !(q[j] < _key[k[j]]);
+                }
+            for (int j = 0; j < g; j++) {
+                if (k[j] <= _n) k[j] = 2 * k[j] + !(q[j] < _key[k[j]]);
+                out[base + j] = result(k[j]);
+            }
+        }
+    }
+};
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <climits>      // 为了使用 INT_MAX
+#include <cstdint>      // 为了使用 std::uint32_t, std::int64_t, std::uintptr_t, SIZE_MAX
+#include <cstring>      // 为了使用 std::memcpy, std::memmove, std::memcmp
+#include <stdexcept>    // 为了使用 std::runtime_error
+#include <string>       // 为了使用 std::string
+#include <type_traits>  // 为了使用 std::is_trivially_copyable
+
+#include <fcntl.h>     // 为了使用 open()
+#include <sys/mman.h>  // 为了使用 mmap(), munmap(), msync()
+#include <sys/stat.h>  // 为了使用 fstat()
+#include <unistd.h>    // 为了使用 ftruncate(), close()
+
+#include "Vector.cpp"
+
+// 文件的打开方式
+enum MapMode {
+    MAPPED_OPEN,      // 打开已有文件，不存在时新建
+    MAPPED_CREATE,    // 新建文件，已有内容被清空
+    MAPPED_READ_ONLY  // 只读打开已有文件，不得修改元素
+};
+
+// 元素类型标记，写入文件头以防止按错误的类型打开；其余可平凡复制的类型记为 0，只校验元素大小
+template <typename T> struct MappedTypeTag { static const std::uint32_t value = 0; };
+template <> struct MappedTypeTag<int> { static const std::uint32_t value = 1; };
+template <> struct MappedTypeTag<long long> { static const std::uint32_t value = 2; };
+template <> struct MappedTypeTag<float> { static const std::uint32_t value = 3; };
+template <> struct MappedTypeTag<double> { static const std::uint32_t value = 4; };
+
+// 文件头，占满一个缓存行，其后紧接数据区
+struct MappedHeader {
+    char magic[8];            // "DSVECTOR"
+    std::uint32_t elemSize;   // sizeof(T)
+    std::uint32_t typeTag;    // MappedTypeTag<T>::value
+    std::int64_t size;        // 规模
+    std::int64_t capacity;    // 数据区容量（元素个数）
+    char reserved[32];
+};
+
+// 以内存映射文件为数据区的向量（仅限 POSIX 系统）：打开已有文件只需映射，不解析也不复制，
+// 规模与容量记录在文件头中，扩容时先 ftruncate 延长文件再重新映射。
+// 只适用于可平凡复制的元素类型；查找、遍历、排序等直接作用于映射区，对元素的修改随映射写回文件
+template <typename T>
+class MappedVector : private Vector<T> {
+    static_assert(std::is_trivially_copyable<T>::value, "MappedVector requires a trivially copyable element type");
+
+private:
+    typedef Vector<T> Base;
+
+    int _fd;                // 文件描述符
+    bool _readOnly;         // 是否只读
+    MappedHeader* _header;  // 映射区起点（文件头）
+    std::size_t _bytes;     // 映射区字节数
+
+    static std::size_t bytesFor(std::int64_t capacity) { return sizeof(MappedHeader) + (std::size_t)capacity * sizeof(T); }
+
+    // 映射文件的前 bytes 个字节，失败时返回 MAP_FAILED
+    void* mapBytes(std::size_t bytes) const {
+        int prot = _readOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+        return mmap(nullptr, bytes, prot, MAP_SHARED, _fd, 0);
+    }
+
+    // 令基类的数据区指向映射区 p（作为内嵌缓冲区登记，基类不会试图释放它）
+    void attach(void* p, std::size_t bytes) {
+        _header = static_cast<MappedHeader*>(p);
+        _bytes = bytes;
+        this->_elem = this->_inline = reinterpret_cast<T*>(_header + 1);
+        this->_capacity = this->_inlineCapacity = (int)_header->capacity;
+        this->_size = (int)_header->size;
+    }
+
+    // 映射整个文件
+    void map(std::size_t bytes) {
+        void* p = mapBytes(bytes);
+        if (p == MAP_FAILED) throw std::runtime_error("MappedVector: mmap failed");
+        attach(p, bytes);
+    }
+
+    void unmap() {
+        if (_header) munmap(_header, _bytes);
+        _header = nullptr;
+    }
+
+    // 将容量调整为 c：先延长（或截短）文件并映射新的长度，成功后才解除旧映射、改写文件头中的容量。
+    // 任一步失败时文件长度、文件头与旧映射均保持原样，对象仍然可用
+    void remap(int c) {
+        std::size_t bytes = bytesFor(c);
+        if (ftruncate(_fd, (off_t)bytes) != 0) throw std::runtime_error("MappedVector: ftruncate failed");
+        void* p = mapBytes(bytes);
+        if (p == MAP_FAILED) {
+            int restored = ftruncate(_fd, (off_t)_bytes);  // 恢复原长度；截短时旧映射的尾部须仍在文件内
+            (void)restored;
+            throw std::runtime_error("MappedVector: mmap failed");
+        }
+        munmap(_header, _bytes);
+        static_cast<MappedHeader*>(p)->capacity = c;
+        attach(p, bytes);
+    }
+
+    // 确保容量至少为 c，不足时按加倍策略扩容（不超过 INT_MAX）
+    void reserveFor(int c) {
+        if (c <= this->_capacity) return;
+        long long n = (long long)std::max(this->_capacity, DEFAULT_CAPACITY) << 1;
+        remap((int)std::min<long long>(std::max<long long>(n, c), INT_MAX));
+    }
+
+    // 修改元素或规模之前调用：只读映射的页面不可写，写入会导致 SIGSEGV，故改为抛出异常
+    void requireWritable() const {
+        if (_readOnly) throw std::runtime_error("MappedVector: the mapping is read-only");
+    }
+
+    void syncSize() { _header->size = this->_size; }
+
+    void close() {
+        unmap();
+        if (_fd >= 0) ::close(_fd);
+        _fd = -1;
+        this->_elem = this->_inline = nullptr;
+        this->_size = this->_capacity = this->_inlineCapacity = 0;
+    }
+
+public:
+    explicit MappedVector(std::string const& path, MapMode mode = MAPPED_OPEN)
+        : Base(std::allocator<T>(), nullptr, 0), _fd(-1), _readOnly(mode == MAPPED_READ_ONLY), _header(nullptr), _bytes(0) {
+        int flags = _readOnly ? O_RDONLY : O_RDWR | O_CREAT | (mode == MAPPED_CREATE ? O_TRUNC : 0);
+        _fd = ::open(path.c_str(), flags, 0644);
+        if (_fd < 0) throw std::runtime_error("MappedVector: cannot open " + path);
+        struct stat st;
+        if (fstat(_fd, &st) != 0) {
+            close();
+            throw std::runtime_error("MappedVector: cannot stat " + path);
+        }
+        if (st.st_size == 0 && !_readOnly) {  // 新文件：写入文件头
+            MappedHeader h = {};
+            std::memcpy(h.magic, "DSVECTOR", 8);
+            h.elemSize = sizeof(T);
+            h.typeTag = MappedTypeTag<T>::value;
+            h.capacity = DEFAULT_CAPACITY;
+            if (ftruncate(_fd, (off_t)bytesFor(h.capacity)) != 0 || pwrite(_fd, &h, sizeof(h), 0) != (ssize_t)sizeof(h)) {
+                close();
+                throw std::runtime_error("MappedVector: cannot initialize " + path);
+            }
+            st.st_size = (off_t)bytesFor(h.capacity);
+        }
+        MappedHeader h;
+        if ((std::size_t)st.st_size < sizeof(h) || pread(_fd, &h, sizeof(h), 0) != (ssize_t)sizeof(h)
+            || std::memcmp(h.magic, "DSVECTOR", 8) != 0 || h.elemSize != sizeof(T) || h.typeTag != MappedTypeTag<T>::value
+            || h.size < 0 || h.size > h.capacity || h.capacity > INT_MAX  // 基类以 int 记规模与容量
+            || (std::uint64_t)h.capacity > (SIZE_MAX - sizeof(MappedHeader)) / sizeof(T)  // bytesFor() 不得溢出
+            || (std::size_t)st.st_size < bytesFor(h.capacity)) {
+            close();
+            throw std::runtime_error("MappedVector: " + path + " is not a vector file of this element type");
+        }
+        map(bytesFor(h.capacity));
+    }
+
+    ~MappedVector() { close(); }
+
+    MappedVector(MappedVector const&) = delete;
+    MappedVector& operator=(MappedVector const&) = delete;
+
+    // 只读接口与 Vector 相同，直接作用于映射区
+    using Base::size;
+    using Base::capacity;
+    using Base::empty;
+    using Base::disordered;
+    using Base::find;
+    using Base::count;
+    using Base::max;
+    using Base::min;
+    using Base::search;
+
+    bool readOnly() const { return _readOnly; }
+
+    // 下标访问只读，只读映射与可写映射均可使用；修改元素用 at()
+    T const& operator[](Rank r) const { return this->_elem[r]; }
+
+    // 可写的元素引用，只读映射上调用时抛出异常
+    T& at(Rank r) {
+        requireWritable();
+        return this->_elem[r];
+    }
+
+    // 只读遍历
+    template <typename VST>
+    void traverse(VST& visit) const {
+        for (Rank i = 0; i < this->_size; i++) visit(static_cast<T const&>(this->_elem[i]));
+    }
+
+    // 原地排序（参数与 Vector::sort 相同），只申请临时的辅助空间；只读映射上调用时抛出异常
+    template <typename... Args>
+    void sort(Args const&... args) {
+        requireWritable();
+        Base::sort(args...);
+    }
+
+    // 以下修改操作在只读映射上调用时均抛出 std::runtime_error
+
+    // 在末尾追加元素
+    Rank insert(T const& e) {
+        requireWritable();
+        T x = e;  // e 可能位于映射区内，扩容后失效
+        reserveFor(this->_size + 1);
+        this->_elem[this->_size++] = x;
+        syncSize();
+        return this->_size - 1;
+    }
+
+    // 在秩 r 处插入元素
+    Rank insert(Rank r, T const& e) {
+        requireWritable();
+        T x = e;  // e 可能位于映射区内，扩容后失效
+        reserveFor(this->_size + 1);
+        std::memmove(this->_elem + r + 1, this->_elem + r, (this->_size - r) * sizeof(T));
+        this->_elem[r] = x;
+        this->_size++;
+        syncSize();
+        return r;
+    }
+
+    // 在末尾成批追加 A[0, n)，至多扩容一次
+    void append(T const* A, Rank n) {
+        requireWritable();
+        if (n <= 0) return;
+        // A 可能指向映射区内（如追加自身的一段），扩容后按偏移量改指新的映射区
+        std::uintptr_t a = reinterpret_cast<std::uintptr_t>(A), lo = reinterpret_cast<std::uintptr_t>(this->_elem);
+        bool inside = a >= lo && a < lo + (std::uintptr_t)this->_capacity * sizeof(T);
+        std::size_t offset = inside ? A - this->_elem : 0;
+        reserveFor(this->_size + n);
+        if (inside) A = this->_elem + offset;
+        std::memcpy(this->_elem + this->_size, A, n * sizeof(T));
+        this->_size += n;
+        syncSize();
+    }
+
+    // 删除区间 [lo, hi) 之内的元素，容量不变
+    int remove(Rank lo, Rank hi) {
+        requireWritable();
+        std::memmove(this->_elem + lo, this->_elem + hi, (this->_size - hi) * sizeof(T));
+        this->_size -= hi - lo;
+        syncSize();
+        return hi - lo;
+    }
+
+    // 将文件截短到恰好容纳现有元素
+    void shrink_to_fit() {
+        requireWritable();
+        if (this->_capacity > this->_size) remap(this->_size);
+    }
+
+    // 将映射区的修改同步写回文件
+    void flush() {
+        if (!_readOnly) msync(_header, _bytes, MS_SYNC);
+    }
+
+    // 作为普通 Vector 引用传给只读算法（如 EytzingerIndex）
+    Vector<T> const& vector() const { return *this; }
+};
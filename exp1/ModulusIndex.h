@@ -0,0 +1,127 @@
+#pragma once
+
+#include <algorithm>  // 为了使用 std::lower_bound, std::upper_bound, std::merge, std::sort
+#include <utility>    // 为了使用 std::pair
+#include <vector>     // 为了使用 std::vector
+
+#include "Complex.h"
+#include "SortByKey.h"
+
+// 连续存放的一段复数，不持有空间
+struct ComplexSpan {
+    Complex const* first;
+    int count;
+
+    Complex const* begin() const { return first; }
+    Complex const* end() const { return first + count; }
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+    Complex const& operator[](int i) const { return first[i]; }
+};
+
+// 按模排序的复数索引：元素按 (模, 实部) 有序存放（与 compareByModulus 的次序相同），另存各元素模的平方。
+// 模落在 [m1, m2) 内的元素恰好构成一段，由 modulusThreshold() 换算出的门限在模的平方上二分查找即可定位，
+// 结果与 findInRange() 逐个开方比较完全一致。
+// 查询返回的 ComplexSpan 直接指向索引内部，插入元素后失效
+class ModulusIndex {
+private:
+    std::vector<Complex> _elem;  // 按 (模, 实部) 有序
+    std::vector<double> _key;    // _key[i] 为 _elem[i] 的模的平方；模相同的元素之间未必有序，但对任一门限 t，_key[i] < t 的元素总在前面
+
+    // 首个模的平方不小于门限 t 的位置
+    int lowerBound(double t) const { return (int)(std::lower_bound(_key.begin(), _key.end(), t) - _key.begin()); }
+
+    // 在 [lo, n) 中查找首个不小于 t 的位置：自 lo 起按 1, 2, 4, ... 的步长试探，再在最后一步内二分
+    int gallop(int lo, double t) const {
+        int n = (int)_key.size(), step = 1, hi = lo;
+        while (hi < n && _key[hi] < t) {
+            lo = hi + 1;
+            hi += step;
+            step <<= 1;
+        }
+        if (hi > n) hi = n;
+        return (int)(std::lower_bound(_key.begin() + lo, _key.begin() + hi, t) - _key.begin());
+    }
+
+    static bool before(std::pair<double, double> const& a, Complex const& b) {
+        return a < std::make_pair(b.modulus(), b.real);
+    }
+
+    void rebuildKeys() {
+        _key.resize(_elem.size());
+        for (size_t i = 0; i < _elem.size(); i++) _key[i] = _elem[i].squaredModulus();
+    }
+
+public:
+    ModulusIndex() {}
+
+    // 由任意次序的复数构造，排序一次
+    explicit ModulusIndex(std::vector<Complex> const& vec) : _elem(vec) {
+        sort_by_key(_elem.begin(), _elem.end(), [](Complex const& c) { return std::make_pair(c.modulus(), c.real); });
+        rebuildKeys();
+    }
+
+    int size() const { return (int)_elem.size(); }
+
+    // 按 (模, 实部) 有序的全部元素
+    ComplexSpan all() const { return ComplexSpan{_elem.data(), size()}; }
+
+    // 模落在 [m1, m2) 内的元素
+    ComplexSpan range(double m1, double m2) const {
+        double t1 = modulusThreshold(m1), t2 = modulusThreshold(m2);
+        if (t1 != t1 || t2 != t2) return ComplexSpan{_elem.data(), 0};  // 区间端点为 NaN：没有元素满足
+        int lo = lowerBound(t1), hi = lowerBound(t2);
+        return ComplexSpan{_elem.data() + lo, hi > lo ? hi - lo : 0};
+    }
+
+    // 成批查询：out[i] 为 [m1[i], m2[i]) 的结果。
+    // 全部 2q 个门限排序后自前向后逐个定位，每次从上一个位置起跳跃查找，总代价 O(q log(n / q))
+    void range(double const* m1, double const* m2, int q, ComplexSpan* out) const {
+        std::vector<std::pair<double, int>> bounds;  // (门限, 2i 或 2i + 1)
+        bounds.reserve(2 * q);
+        for (int i = 0; i < q; i++) {
+            double t1 = modulusThreshold(m1[i]), t2 = modulusThreshold(m2[i]);
+            out[i] = ComplexSpan{_elem.data(), 0};
+            if (t1 != t1 || t2 != t2) continue;
+            bounds.emplace_back(t1, 2 * i);
+            bounds.emplace_back(t2, 2 * i + 1);
+        }
+        std::sort(bounds.begin(), bounds.end());
+        std::vector<int> pos(2 * q);
+        int p = 0;
+        for (auto const& b : bounds) pos[b.second] = p = gallop(p, b.first);
+        for (size_t j = 0; j < bounds.size(); j++) {
+            int i = bounds[j].second >> 1;
+            int lo = pos[2 * i], hi = pos[2 * i + 1];
+            out[i] = ComplexSpan{_elem.data() + lo, hi > lo ? hi - lo : 0};
+        }
+    }
+
+    std::vector<ComplexSpan> range(std::vector<std::pair<double, double>> const& ranges) const {
+        std::vector<double> m1(ranges.size()), m2(ranges.size());
+        for (size_t i = 0; i < ranges.size(); i++) m1[i] = ranges[i].first, m2[i] = ranges[i].second;
+        std::vector<ComplexSpan> out(ranges.size());
+        range(m1.data(), m2.data(), (int)ranges.size(), out.data());
+        return out;
+    }
+
+    // 插入单个元素：二分定位后整体后移，O(n)
+    void insert(Complex const& c) {
+        auto key = std::make_pair(c.modulus(), c.real);
+        int r = (int)(std::upper_bound(_elem.begin(), _elem.end(), key, before) - _elem.begin());
+        _elem.insert(_elem.begin() + r, c);
+        _key.insert(_key.begin() + r, c.squaredModulus());
+    }
+
+    // 成批插入：新元素先自行排序，再与原有元素一趟归并，O(n + k log k)
+    void insert(std::vector<Complex> const& batch) {
+        std::vector<Complex> added(batch);
+        auto modulusKey = [](Complex const& c) { return std::make_pair(c.modulus(), c.real); };
+        sort_by_key(added.begin(), added.end(), modulusKey);
+        std::vector<Complex> merged(_elem.size() + added.size());
+        std::merge(_elem.begin(), _elem.end(), added.begin(), added.end(), merged.begin(),
+                   [&](Complex const& a, Complex const& b) { return modulusKey(a) < modulusKey(b); });
+        _elem.swap(merged);
+        rebuildKeys();
+    }
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Vector.cpp"
+
+// 带内嵌缓冲区的向量：至多 N 个元素时直接存放在对象内部，不申请堆空间；超出后才转移到分配器申请的空间，
+// 此后规模缩回 N 以内时（自动缩容或 shrink_to_fit()）再回到内嵌缓冲区。接口与 Vector 相同，可作为 Vector& 传递
+template <typename T, int N, typename Alloc = std::allocator<T>>
+class SmallVector : public Vector<T, Alloc> {
+private:
+    typedef Vector<T, Alloc> Base;
+
+    alignas(T) unsigned char _buffer[N * sizeof(T)];  // 内嵌缓冲区（原始空间）
+
+    T* buffer() { return reinterpret_cast<T*>(_buffer); }
+
+public:
+    explicit SmallVector(Alloc const& alloc = Alloc()) : Base(alloc, buffer(), N) {}
+
+    // 规模为 s、各元素均为 v
+    SmallVector(int s, T const& v, Alloc const& alloc = Alloc()) : Base(alloc, buffer(), N) {
+        this->acquire(s);
+        for (; this->_size < s; this->_size++) new (this->_elem + this->_size) T(v);
+    }
+
+    SmallVector(T const* A, Rank n, Alloc const& alloc = Alloc()) : Base(alloc, buffer(), N) { this->copyFrom(A, 0, n); }
+
+    SmallVector(T const* A, Rank lo, Rank hi, Alloc const& alloc = Alloc()) : Base(alloc, buffer(), N) {
+        this->copyFrom(A, lo, hi);
+    }
+
+    SmallVector(Base const& V) : Base(Base::AllocTraits::select_on_container_copy_construction(V.get_allocator()), buffer(), N) {
+        this->copyFrom(V.size() ? &V[0] : nullptr, 0, V.size());
+    }
+
+    SmallVector(SmallVector const& V) : SmallVector(static_cast<Base const&>(V)) {}
+
+    // 移动构造：V 在堆上时直接接管其数据区，否则逐个搬迁到本对象的内嵌缓冲区
+    SmallVector(SmallVector&& V) noexcept : Base(V.get_allocator(), buffer(), N) { Base::operator=(std::move(V)); }
+
+    SmallVector& operator=(SmallVector const& V) {
+        Base::operator=(V);
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& V) noexcept {
+        Base::operator=(std::move(V));
+        return *this;
+    }
+
+    // 元素当前是否存放在内嵌缓冲区中
+    bool isInline() const { return this->_elem == this->_inline; }
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <algorithm>    // 为了使用 std::sort
+#include <iterator>     // 为了使用 std::iterator_traits
+#include <type_traits>  // 为了使用 std::is_trivially_copyable, std::decay
+#include <utility>      // 为了使用 std::pair, std::move
+#include <vector>       // 为了使用 std::vector
+
+// 按缓存的键排序：对 [first, last) 中每个元素只调用一次 key()，之后的比较只比较键。
+// 适用于键的计算代价远高于比较本身的情形（例如按复数的模排序，每次比较都要两次开方）。
+// 元素较小且可平凡复制时直接排序 (键, 元素) 对，省去最后按下标收集的随机访问；否则排序 (键, 下标) 对再重排。
+// 与 std::sort 一样不稳定：键相等的元素之间的次序不确定
+template <typename It, typename KeyFn>
+void sort_by_key(It first, It last, KeyFn key) {
+    typedef typename std::iterator_traits<It>::value_type T;
+    typedef typename std::decay<decltype(key(*first))>::type K;
+    auto byKey = [](auto const& a, auto const& b) { return a.first < b.first; };
+    int n = (int)(last - first);
+    if (n < 2) return;
+    if (std::is_trivially_copyable<T>::value && sizeof(T) <= 16) {
+        std::vector<std::pair<K, T>> keyed;
+        keyed.reserve(n);
+        for (It it = first; it != last; ++it) keyed.emplace_back(key(*it), *it);
+        std::sort(keyed.begin(), keyed.end(), byKey);
+        for (int i = 0; i < n; i++) first[i] = keyed[i].second;
+    } else {
+        std::vector<std::pair<K, int>> keyed;
+        keyed.reserve(n);
+        for (int i = 0; i < n; i++) keyed.emplace_back(key(first[i]), i);
+        std::sort(keyed.begin(), keyed.end(), byKey);
+        std::vector<T> sorted;
+        sorted.reserve(n);
+        for (int i = 0; i < n; i++) sorted.push_back(std::move(first[keyed[i].second]));
+        for (int i = 0; i < n; i++) first[i] = std::move(sorted[i]);
+    }
+}
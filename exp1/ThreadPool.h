@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>           // 为了使用 std::min, std::max
+#include <atomic>              // 为了使用 std::atomic
+#include <condition_variable>  // 为了使用 std::condition_variable
+#include <functional>          // 为了使用 std::function
+#include <mutex>               // 为了使用 std::mutex
+#include <queue>               // 为了使用 std::queue
+#include <thread>              // 为了使用 std::thread
+#include <vector>              // 为了使用 std::vector
+
+// 固定规模的任务池：size() 个线程中包含调用线程本身，另外 size() - 1 个为后台工作线程
+class ThreadPool {
+private:
+    std::vector<std::thread> _workers;          // 后台工作线程
+    std::queue<std::function<void()>> _tasks;   // 待执行的任务
+    std::mutex _mutex;
+    std::condition_variable _ready;             // 有新任务或需要退出
+    bool _stop;
+
+    // 工作线程主循环
+    void work() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _ready.wait(lock, [this] { return _stop || !_tasks.empty(); });
+                if (_tasks.empty()) return;  // 已要求退出且任务都已完成
+                task = std::move(_tasks.front());
+                _tasks.pop();
+            }
+            task();
+        }
+    }
+
+public:
+    // threads 为参与计算的线程总数，0 表示取硬件并发数
+    explicit ThreadPool(int threads = 0) : _stop(false) {
+        if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        for (int i = 1; i < threads; i++) _workers.emplace_back([this] { work(); });
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _ready.notify_all();
+        for (std::thread& t : _workers) t.join();
+    }
+
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+
+    int size() const { return (int)_workers.size() + 1; }  // 参与计算的线程总数
+
+    // 提交一个任务，由某个后台线程异步执行
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tasks.push(std::move(task));
+        }
+        _ready.notify_one();
+    }
+
+    // 对 i = 0, 1, ..., count - 1 并行执行 f(i)，调用线程也参与；返回时全部执行完毕
+    template <typename F>
+    void parallelFor(int count, F f) {
+        std::atomic<int> next(0);  // 下一个待领取的下标
+        int helpers = std::min((int)_workers.size(), count - 1);
+        int finished = 0;  // 已退出的后台协助者
+        std::mutex doneMutex;
+        std::condition_variable done;
+        auto run = [&] {
+            for (int i; (i = next++) < count;) f(i);
+        };
+        for (int h = 0; h < helpers; h++)
+            submit([&] {
+                run();
+                std::lock_guard<std::mutex> lock(doneMutex);
+                if (++finished == helpers) done.notify_one();
+            });
+        run();
+        std::unique_lock<std::mutex> lock(doneMutex);
+        done.wait(lock, [&] { return finished == helpers; });  // 等待协助者全部退出，局部状态才可安全销毁
+    }
+};
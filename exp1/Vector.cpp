@@ -1,44 +1,115 @@
-#include <algorithm>  // 为了使用 std::swap, std::make_heap, std::pop_heap
-#include <cstdlib>    // 为了使用 rand()
+#pragma once
+
+#include <algorithm>    // 为了使用 std::swap, std::make_heap, std::pop_heap
+#include <cstdlib>      // 为了使用 rand()
+#include <cstring>      // 为了使用 std::memcpy
+#include <functional>   // 为了使用 std::hash
+#include <iterator>     // 为了使用 std::make_move_iterator
+#include <memory>       // 为了使用 std::allocator, std::allocator_traits, std::uninitialized_copy
+#include <new>          // 为了使用定位 new
+#include <type_traits>  // 为了使用 std::is_trivially_copyable
+#include <utility>      // 为了使用 std::move, std::forward
+#include <vector>       // 为了使用 std::vector
+
+#include "ThreadPool.h"
+#include "VectorSimd.h"
 
 typedef int Rank;  // 定义Rank类型
 
 #define DEFAULT_CAPACITY 3  // 默认的初始容量
 
+// 可选的排序算法
+enum SortMethod { BUBBLE_SORT, SELECTION_SORT, MERGE_SORT, QUICK_SORT, HEAP_SORT, ADAPTIVE_SORT };
+
+// 排序的执行策略：threads 为参与排序的线程数，0 表示取硬件并发数
+struct ExecutionPolicy {
+    int threads;
+    explicit ExecutionPolicy(int t = 0) : threads(t) {}
+};
+
+// 判断类型 T 能否用 std::hash 散列
+template <typename T, typename = void>
+struct IsHashable : std::false_type {};
 template <typename T>
+struct IsHashable<T, decltype((void)std::hash<T>()(std::declval<T const&>()))> : std::true_type {};
+
+// Alloc 为分配器类型，默认使用全局堆；成批创建、一起丢弃的向量可改用 Arena.h 中的 ArenaAllocator
+template <typename T, typename Alloc = std::allocator<T>>
 class Vector {
 protected:
+    typedef std::allocator_traits<Alloc> AllocTraits;
+
     Rank _size;       // 规模
     int _capacity;    // 容量
-    T* _elem;         // 数据区
+    T* _elem;         // 数据区：[0, _size) 为已构造的元素，[_size, _capacity) 为未构造的原始空间
+    Alloc _alloc;     // 分配器
+    bool _autoShrink = true;  // 装填因子过小时是否自动缩容；调用 reserve() 或 shrink_to_fit() 后由使用者自行管理容量
+    T* _inline = nullptr;     // 派生类（SmallVector）提供的内嵌缓冲区，不经分配器申请与释放
+    int _inlineCapacity = 0;  // 内嵌缓冲区的容量
+
+    // 申请可容纳 n 个元素的原始空间（不调用构造函数）
+    T* allocate(int n) { return AllocTraits::allocate(_alloc, n); }
+
+    // 释放容量为 n 的原始空间（不调用析构函数）；内嵌缓冲区无需释放
+    void release(T* p, int n) {
+        if (p && p != _inline) AllocTraits::deallocate(_alloc, p, n);
+    }
+
+    // 取得容量至少为 c 的数据区：内嵌缓冲区足够时优先使用，否则向分配器申请
+    void acquire(int c) {
+        if (_inline && c <= _inlineCapacity) _elem = _inline, _capacity = _inlineCapacity;
+        else _elem = allocate(_capacity = c);
+    }
+
+    // 析构 A[lo, hi) 内的元素，空间本身保留
+    static void destroy(T* A, Rank lo, Rank hi) {
+        if (std::is_trivially_destructible<T>::value) return;
+        while (lo < hi) A[lo++].~T();
+    }
+    void destroy(Rank lo, Rank hi) { destroy(_elem, lo, hi); }
+
+    // 将 src 中的 n 个元素搬迁到原始空间 dst：可平凡复制的类型直接 memcpy，否则逐个移动构造并析构原对象
+    static void relocate(T* dst, T* src, Rank n) {
+        if (std::is_trivially_copyable<T>::value) {
+            if (n > 0) std::memcpy(static_cast<void*>(dst), static_cast<void const*>(src), n * sizeof(T));
+            return;
+        }
+        for (Rank i = 0; i < n; i++) {
+            new (dst + i) T(std::move(src[i]));
+            src[i].~T();
+        }
+    }
+
+    // 将数据区更换为容量为 c 的新空间，原有元素搬迁过去
+    void reallocate(int c) {
+        if (_elem && _elem == _inline && c <= _inlineCapacity) return;  // 已在内嵌缓冲区中
+        T* oldElem = _elem;
+        int oldCapacity = _capacity;
+        acquire(c);
+        relocate(_elem, oldElem, _size);
+        release(oldElem, oldCapacity);  // 释放原空间
+    }
 
     // 从数组区间 A[lo, hi) 复制内容到当前向量
     void copyFrom(T const* A, Rank lo, Rank hi) {
-        _elem = new T[_capacity = 2 * (hi - lo)];  // 为新向量申请空间
-        _size = 0;
-        while (lo < hi) {
-            _elem[_size++] = A[lo++];  // 复制元素
-        }
+        acquire(hi - lo <= _inlineCapacity ? hi - lo : 2 * (hi - lo));  // 为新向量申请空间，容纳得下时使用内嵌缓冲区
+        std::uninitialized_copy(A + lo, A + hi, _elem);  // 直接在原始空间上复制构造
+        _size = hi - lo;
     }
 
     // 当空间不足时扩展容量
     void expand() {
         if (_size < _capacity) return;  // 空间尚足，无需扩容
         _capacity = std::max(_capacity, DEFAULT_CAPACITY);  // 确保最小容量为 DEFAULT_CAPACITY
-        T* oldElem = _elem;
-        _elem = new T[_capacity <<= 1];  // 容量加倍
-        for (int i = 0; i < _size; i++) _elem[i] = oldElem[i];  // 复制原向量内容
-        delete[] oldElem;  // 释放原空间
+        reallocate(_capacity << 1);  // 容量加倍
     }
 
     // 当装填因子过小时收缩容量
     void shrink() {
+        if (!_autoShrink) return;  // 容量由使用者管理
         if (_capacity < DEFAULT_CAPACITY << 1) return;  // 不致收缩到 DEFAULT_CAPACITY 以下
         if (_size << 2 > _capacity) return;  // 装填因子高于 25% 时不收缩
-        T* oldElem = _elem;
-        _elem = new T[_capacity >>= 1];  // 容量减半
-        for (int i = 0; i < _size; i++) _elem[i] = oldElem[i];  // 复制原向量内容
-        delete[] oldElem;  // 释放原空间
+        reallocate(_capacity >> 1);  // 容量减半
     }
 
     // 冒泡排序中的一趟冒泡操作
@@ -57,55 +128,55 @@ protected:
         while (!bubble(lo, hi--));  // 逐趟扫描直到完全有序
     }
 
-    // 选取区间中最大元素的秩
-    Rank max(Rank lo, Rank hi) {
-        Rank max = lo;
-        while (++lo < hi)
-            if (_elem[max] < _elem[lo]) max = lo;  // 记录更大元素的位置
-        return max;
-    }
-
     // 选择排序算法
     void selectionSort(Rank lo, Rank hi) {
         while (lo < --hi)
             std::swap(_elem[max(lo, hi)], _elem[hi]);  // 将最大元素交换至末尾
     }
 
-    // 归并算法
-    void merge(Rank lo, Rank mi, Rank hi) {
+    // 归并算法，B 为至少可容纳 mi - lo 个元素的原始空间
+    void merge(Rank lo, Rank mi, Rank hi, T* B) {
         T* A = _elem + lo;  // 合并后的数组
         int lb = mi - lo;
-        T* B = new T[lb];  // 辅助数组 B
-        for (Rank i = 0; i < lb; B[i] = A[i++]);  // 复制前半部分
+        for (Rank i = 0; i < lb; i++) new (B + i) T(std::move(A[i]));  // 移出前半部分
         int lc = hi - mi;
         T* C = _elem + mi;  // 后半部分的数组
-        for (Rank i = 0, j = 0, k = 0; (j < lb) || (k < lc);) {
-            if ((j < lb) && (!(k < lc) || (B[j] <= C[k]))) A[i++] = B[j++];
-            if ((k < lc) && (!(j < lb) || (C[k] < B[j]))) A[i++] = C[k++];
+        for (Rank i = 0, j = 0, k = 0; j < lb;) {  // B 用尽后，C 的剩余部分已在原位，无需再移动
+            if ((k < lc) && (C[k] < B[j])) A[i++] = std::move(C[k++]);
+            else A[i++] = std::move(B[j++]);
         }
-        delete[] B;  // 释放辅助数组
+        destroy(B, 0, lb);
+    }
+
+    // 归并排序算法（递归部分），所有层次共用同一辅助空间 B
+    void mergeSort(Rank lo, Rank hi, T* B) {
+        if (hi - lo < 2) return;  // 单元素区间自然有序
+        Rank mi = (lo + hi) / 2;
+        mergeSort(lo, mi, B);  // 对前半部分排序
+        mergeSort(mi, hi, B);  // 对后半部分排序
+        merge(lo, mi, hi, B);  // 归并
     }
 
     // 归并排序算法
     void mergeSort(Rank lo, Rank hi) {
         if (hi - lo < 2) return;  // 单元素区间自然有序
-        Rank mi = (lo + hi) / 2;
-        mergeSort(lo, mi);  // 对前半部分排序
-        mergeSort(mi, hi);  // 对后半部分排序
-        merge(lo, mi, hi);  // 归并
+        int lb = (hi - lo) / 2;  // 任一次归并的前半部分都不超过这个长度
+        T* B = allocate(lb);  // 整个排序只申请一次辅助空间
+        mergeSort(lo, hi, B);
+        release(B, lb);
     }
 
     // 枢点构造算法（用于快速排序）
     Rank partition(Rank lo, Rank hi) {
         std::swap(_elem[lo], _elem[lo + rand() % (hi - lo)]);  // 随机选择一个轴点并与首元素交换
-        T pivot = _elem[lo];  // 以第一个元素为轴点
+        T pivot = std::move(_elem[lo]);  // 以第一个元素为轴点
         while (lo < hi) {
             while ((lo < hi) && (pivot <= _elem[--hi]));
-            _elem[lo] = _elem[hi];
+            _elem[lo] = std::move(_elem[hi]);
             while ((lo < hi) && (_elem[++lo] <= pivot));
-            _elem[hi] = _elem[lo];
+            _elem[hi] = std::move(_elem[lo]);
         }
-        _elem[lo] = pivot;  // 轴点归位
+        _elem[lo] = std::move(pivot);  // 轴点归位
         return lo;  // 返回轴点秩
     }
 
@@ -125,45 +196,344 @@ protected:
         }
     }
 
+    static const int MIN_RUN = 32;     // 自然段的最短长度，不足者以插入排序补足
+    static const int MIN_GALLOP = 7;   // 一方连续胜出这么多次后进入飞奔模式
+
+    // 识别从 lo 开始的自然段并返回其末端；严格降序段就地翻转为升序（严格保证稳定性）
+    Rank countRun(Rank lo, Rank hi) {
+        Rank r = lo + 1;
+        if (r == hi) return hi;
+        if (_elem[r] < _elem[lo]) {
+            while ((++r < hi) && (_elem[r] < _elem[r - 1]));
+            std::reverse(_elem + lo, _elem + r);
+        } else {
+            while ((++r < hi) && !(_elem[r] < _elem[r - 1]));
+        }
+        return r;
+    }
+
+    // 二分插入排序：[lo, start) 已有序，将 [start, hi) 逐个插入
+    void binaryInsertionSort(Rank lo, Rank start, Rank hi) {
+        for (; start < hi; start++) {
+            T e = std::move(_elem[start]);
+            Rank pos = lo + gallop(e, _elem + lo, start - lo, true, true);  // 相等者之后，保持稳定
+            for (Rank i = start; i > pos; i--) _elem[i] = std::move(_elem[i - 1]);
+            _elem[pos] = std::move(e);
+        }
+    }
+
+    // 识别自然段，过短者扩展到 MIN_RUN
+    Rank extendRun(Rank lo, Rank hi) {
+        Rank r = countRun(lo, hi);
+        if (r - lo < MIN_RUN) {
+            Rank end = std::min(hi, lo + MIN_RUN);
+            binaryInsertionSort(lo, r, end);
+            r = end;
+        }
+        return r;
+    }
+
+    // 在有序区间 A[0, n) 中倍增查找 key 的插入位置：right 为真时返回第一个大于 key 的位置，否则返回第一个不小于 key 的位置
+    // fromEnd 为真时从右端开始倍增；代价为 O(log d)，d 为结果到出发端的距离
+    static Rank gallop(T const& key, T const* A, Rank n, bool right, bool fromEnd) {
+        Rank lo = 0, hi = n, step = 1;
+        if (!fromEnd) {
+            while ((lo + step <= n) && goesAfter(key, A[lo + step - 1], right)) { lo += step; step <<= 1; }
+            hi = std::min(n, lo + step);
+        } else {
+            while ((hi - step >= 0) && !goesAfter(key, A[hi - step], right)) { hi -= step; step <<= 1; }
+            lo = std::max(0, hi - step + 1);
+        }
+        while (lo < hi) {
+            Rank mi = (lo + hi) >> 1;
+            if (goesAfter(key, A[mi], right)) lo = mi + 1;
+            else hi = mi;
+        }
+        return lo;
+    }
+
+    // key 是否应排在 x 之后：right 为真时相等者也排在后面
+    static bool goesAfter(T const& key, T const& x, bool right) { return right ? !(key < x) : (x < key); }
+
+    // 归并 [lo, mi) 与 [mi, hi)，前段较短：前段移入 B，自左向右归并
+    void mergeLo(Rank lo, Rank mi, Rank hi, T* B) {
+        int na = mi - lo;
+        for (Rank i = 0; i < na; i++) new (B + i) T(std::move(_elem[lo + i]));
+        Rank i = 0, j = mi, dest = lo;  // i < na 时必有 dest < j，不会覆盖后段中尚未归并的元素
+        int minGallop = MIN_GALLOP;
+        while ((i < na) && (j < hi)) {
+            int countA = 0, countB = 0;  // 前、后段各自连续胜出的次数
+            while ((i < na) && (j < hi)) {  // 逐个比较
+                if (_elem[j] < B[i]) {
+                    _elem[dest++] = std::move(_elem[j++]);
+                    countA = 0;
+                    if (++countB >= minGallop) break;
+                } else {
+                    _elem[dest++] = std::move(B[i++]);
+                    countB = 0;
+                    if (++countA >= minGallop) break;
+                }
+            }
+            while ((i < na) && (j < hi)) {  // 飞奔：成段搬移，直到两侧的段都变短
+                countA = gallop(_elem[j], B + i, na - i, true, false);
+                for (Rank k = 0; k < countA; k++) _elem[dest++] = std::move(B[i++]);
+                if (i == na) break;
+                countB = gallop(B[i], _elem + j, hi - j, false, false);
+                for (Rank k = 0; k < countB; k++) _elem[dest++] = std::move(_elem[j++]);
+                if (j == hi) break;
+                minGallop = std::max(0, minGallop - 1);
+                if ((countA < MIN_GALLOP) && (countB < MIN_GALLOP)) break;
+            }
+            minGallop += 2;  // 飞奔收益不佳，提高再次进入的门槛
+        }
+        while (i < na) _elem[dest++] = std::move(B[i++]);  // 后段的剩余部分已在原位
+        destroy(B, 0, na);
+    }
+
+    // 归并 [lo, mi) 与 [mi, hi)，后段较短：后段移入 B，自右向左归并
+    void mergeHi(Rank lo, Rank mi, Rank hi, T* B) {
+        int nb = hi - mi;
+        for (Rank j = 0; j < nb; j++) new (B + j) T(std::move(_elem[mi + j]));
+        Rank i = mi - 1, j = nb - 1, dest = hi - 1;  // j >= 0 时必有 dest > i
+        int minGallop = MIN_GALLOP;
+        while ((i >= lo) && (j >= 0)) {
+            int countA = 0, countB = 0;
+            while ((i >= lo) && (j >= 0)) {
+                if (B[j] < _elem[i]) {
+                    _elem[dest--] = std::move(_elem[i--]);
+                    countB = 0;
+                    if (++countA >= minGallop) break;
+                } else {
+                    _elem[dest--] = std::move(B[j--]);
+                    countA = 0;
+                    if (++countB >= minGallop) break;
+                }
+            }
+            while ((i >= lo) && (j >= 0)) {
+                countA = i + 1 - lo - gallop(B[j], _elem + lo, i + 1 - lo, true, true);  // 前段中大于 B[j] 者
+                for (Rank k = 0; k < countA; k++) _elem[dest--] = std::move(_elem[i--]);
+                if (i < lo) break;
+                countB = j + 1 - gallop(_elem[i], B, j + 1, false, true);  // B 中不小于 _elem[i] 者
+                for (Rank k = 0; k < countB; k++) _elem[dest--] = std::move(B[j--]);
+                if (j < 0) break;
+                minGallop = std::max(0, minGallop - 1);
+                if ((countA < MIN_GALLOP) && (countB < MIN_GALLOP)) break;
+            }
+            minGallop += 2;
+        }
+        while (j >= 0) _elem[dest--] = std::move(B[j--]);  // 前段的剩余部分已在原位
+        destroy(B, 0, nb);
+    }
+
+    // 归并相邻的有序段 [lo, mi) 与 [mi, hi)；B 至少可容纳较短的一段
+    void mergeRuns(Rank lo, Rank mi, Rank hi, T* B) {
+        lo += gallop(_elem[mi], _elem + lo, mi - lo, true, false);  // 前段中不大于后段首元素者已在原位
+        if (lo == mi) return;
+        hi = mi + gallop(_elem[mi - 1], _elem + mi, hi - mi, false, true);  // 后段中不小于前段末元素者已在原位
+        if (mi - lo <= hi - mi) mergeLo(lo, mi, hi, B);
+        else mergeHi(lo, mi, hi, B);
+    }
+
+    // powersort 中相邻两段 [s1, s2) 与 [s2, e2) 分界点的深度
+    static int nodePower(Rank lo, Rank hi, Rank s1, Rank s2, Rank e2) {
+        unsigned long long twoN = 2ULL * (hi - lo);
+        unsigned long long a = ((unsigned long long)(s1 + s2 - 2 * lo) << 30) / twoN;  // 前段中点，定点小数
+        unsigned long long b = ((unsigned long long)(s2 + e2 - 2 * lo) << 30) / twoN;  // 后段中点
+        unsigned long long x = a ^ b;
+        int power = 0;
+        while ((power < 31) && !(x & (1ULL << 30))) { power++; x <<= 1; }  // 两中点二进制展开的公共前缀长度
+        return power;
+    }
+
+    // 自适应归并排序（powersort）：利用已有的升序、降序段，按分界点深度决定归并次序，整个排序共用一块辅助空间
+    void adaptiveSort(Rank lo, Rank hi) {
+        if (hi - lo < 2) return;
+        int lb = (hi - lo) / 2;  // 每次归并只移出较短的一段
+        T* B = allocate(lb);
+        adaptiveSort(lo, hi, B);
+        release(B, lb);
+    }
+
+    // 自适应归并排序的主体，B 为至少可容纳 (hi - lo) / 2 个元素的原始空间
+    void adaptiveSort(Rank lo, Rank hi, T* B) {
+        if (hi - lo < 2) return;
+        struct Pending { Rank lo; int power; } stack[64];  // 分界点深度沿栈严格递增，深度不超过 31
+        int top = 0;
+        Rank s1 = lo, e1 = extendRun(lo, hi);
+        while (e1 < hi) {
+            Rank s2 = e1, e2 = extendRun(s2, hi);
+            int power = nodePower(lo, hi, s1, s2, e2);
+            while ((top > 0) && (stack[top - 1].power > power)) {  // 更深的分界点先归并
+                mergeRuns(stack[top - 1].lo, s1, e1, B);
+                s1 = stack[--top].lo;
+            }
+            stack[top].lo = s1;
+            stack[top++].power = power;
+            s1 = s2;
+            e1 = e2;
+        }
+        while (top > 0) {
+            mergeRuns(stack[top - 1].lo, s1, hi, B);
+            s1 = stack[--top].lo;
+        }
+    }
+
+    static const int PARALLEL_CUTOFF = 1 << 15;  // 每个线程至少分得这么多元素，否则并行不划算
+
+    // 将有序的 A[0, la) 与 B[0, lb) 归并到 out（均为已构造的对象，移动赋值），相等时 A 中元素在前
+    static void mergeInto(T* A, Rank la, T* B, Rank lb, T* out) {
+        Rank i = 0, j = 0;
+        while ((i < la) && (j < lb)) {
+            if (B[j] < A[i]) *out++ = std::move(B[j++]);
+            else *out++ = std::move(A[i++]);
+        }
+        while (i < la) *out++ = std::move(A[i++]);
+        while (j < lb) *out++ = std::move(B[j++]);
+    }
+
+    // 归并路径划分：A 与 B 归并后的前 d 个元素中，来自 A 的有多少个
+    static Rank mergePath(T const* A, Rank la, T const* B, Rank lb, Rank d) {
+        Rank lo = std::max(0, d - lb), hi = std::min(d, la);
+        while (lo < hi) {
+            Rank mi = (lo + hi) >> 1;
+            if (B[d - mi - 1] < A[mi]) hi = mi;
+            else lo = mi + 1;
+        }
+        return lo;
+    }
+
+    // 多线程排序：各线程先对各自的分块做自适应排序，再逐轮两两归并；
+    // 每轮的每次归并又按归并路径切成若干互不重叠的小段，使所有线程在每一轮都有活干
+    void parallelSort(Rank lo, Rank hi, ExecutionPolicy const& policy) {
+        int n = hi - lo;
+        int threads = policy.threads > 0 ? policy.threads : (int)std::max(1u, std::thread::hardware_concurrency());
+        threads = std::min(threads, n / PARALLEL_CUTOFF);
+        if (threads < 2) {  // 规模太小，退化为串行排序
+            adaptiveSort(lo, hi);
+            return;
+        }
+        ThreadPool pool(threads);
+        T* A = _elem + lo;
+        T* tmp = allocate(n);  // 先作各分块排序的辅助空间，再作归并的乒乓缓冲区
+        std::vector<Rank> bound(threads + 1);  // 第 i 块为 [bound[i], bound[i + 1])
+        for (int i = 0; i <= threads; i++) bound[i] = (Rank)((long long)n * i / threads);
+
+        pool.parallelFor(threads, [&](int i) {
+            adaptiveSort(lo + bound[i], lo + bound[i + 1], tmp + bound[i]);  // 各块的辅助空间互不重叠
+            std::uninitialized_copy(std::make_move_iterator(A + bound[i]), std::make_move_iterator(A + bound[i + 1]),
+                                    tmp + bound[i]);  // 有序块移入缓冲区，其后两侧均为已构造的对象
+        });
+
+        T* src = tmp;
+        T* dst = A;
+        for (int width = 1; width < threads; width <<= 1) {  // 每轮将相邻两组（各含 width 块）归并
+            int pairs = (threads + 2 * width - 1) / (2 * width);
+            int parts = std::max(1, threads / pairs);  // 每次归并切成的段数
+            std::vector<Rank> split(pairs * (parts + 1));  // 各段起点的输出位置 d 与其中来自前一组的元素数
+            auto range = [&](int p, Rank& l, Rank& m, Rank& h) {
+                l = bound[std::min(threads, 2 * p * width)];
+                m = bound[std::min(threads, (2 * p + 1) * width)];
+                h = bound[std::min(threads, (2 * p + 2) * width)];
+            };
+            pool.parallelFor(pairs * (parts + 1), [&](int k) {  // 先求出全部分点，再开始搬移，以免读到正被移走的元素
+                Rank l, m, h;
+                range(k / (parts + 1), l, m, h);
+                Rank d = (Rank)((long long)(h - l) * (k % (parts + 1)) / parts);
+                split[k] = mergePath(src + l, m - l, src + m, h - m, d);
+            });
+            pool.parallelFor(pairs * parts, [&](int task) {
+                int p = task / parts, part = task % parts;
+                Rank l, m, h;
+                range(p, l, m, h);
+                Rank d0 = (Rank)((long long)(h - l) * part / parts), d1 = (Rank)((long long)(h - l) * (part + 1) / parts);
+                Rank i0 = split[p * (parts + 1) + part], i1 = split[p * (parts + 1) + part + 1];
+                mergeInto(src + l + i0, i1 - i0, src + m + d0 - i0, (d1 - i1) - (d0 - i0), dst + l + d0);
+            });
+            std::swap(src, dst);
+        }
+        if (src != A)  // 最终结果在缓冲区中，搬回数据区
+            pool.parallelFor(threads, [&](int i) { std::move(tmp + bound[i], tmp + bound[i + 1], A + bound[i]); });
+        pool.parallelFor(threads, [&](int i) { destroy(tmp, bound[i], bound[i + 1]); });
+        release(tmp, n);
+    }
+
+    int deduplicate(std::true_type) { return hashDeduplicate(); }
+    int deduplicate(std::false_type) { return scanDeduplicate(); }
+
+    // 供 SmallVector 使用：以容量为 n 的内嵌缓冲区 buffer 作为初始数据区，不申请空间
+    Vector(Alloc const& alloc, T* buffer, int n)
+        : _size(0), _capacity(n), _elem(buffer), _alloc(alloc), _inline(buffer), _inlineCapacity(n) {}
+
+    // 数据区交还之后，回到内嵌缓冲区（没有时为空）
+    void reset() {
+        _elem = _inline;
+        _capacity = _inlineCapacity;
+        _size = 0;
+    }
+
 public:
     // 构造函数
-    Vector(int c = DEFAULT_CAPACITY, int s = 0, T v = 0) {
-        _elem = new T[_capacity = c];
-        for (_size = 0; _size < s; _elem[_size++] = v);  // 初始化数组
+    Vector(int c = DEFAULT_CAPACITY, int s = 0, T const& v = T(), Alloc const& alloc = Alloc()) : _alloc(alloc) {
+        _elem = allocate(_capacity = std::max(c, s));
+        for (_size = 0; _size < s; _size++) new (_elem + _size) T(v);  // 只构造前 s 个元素，其余保持为原始空间
     }
 
-    Vector(T const* A, Rank n) { copyFrom(A, 0, n); }
+    explicit Vector(Alloc const& alloc) : Vector(DEFAULT_CAPACITY, 0, T(), alloc) {}
 
-    Vector(T const* A, Rank lo, Rank hi) { copyFrom(A, lo, hi); }
+    Vector(T const* A, Rank n, Alloc const& alloc = Alloc()) : _alloc(alloc) { copyFrom(A, 0, n); }
 
-    Vector(Vector<T> const& V) { copyFrom(V._elem, 0, V._size); }
+    Vector(T const* A, Rank lo, Rank hi, Alloc const& alloc = Alloc()) : _alloc(alloc) { copyFrom(A, lo, hi); }
 
-    Vector(Vector<T> const& V, Rank lo, Rank hi) { copyFrom(V._elem, lo, hi); }
+    Vector(Vector const& V) : _alloc(AllocTraits::select_on_container_copy_construction(V._alloc)) {
+        copyFrom(V._elem, 0, V._size);
+    }
+
+    Vector(Vector const& V, Rank lo, Rank hi) : _alloc(AllocTraits::select_on_container_copy_construction(V._alloc)) {
+        copyFrom(V._elem, lo, hi);
+    }
+
+    // 移动构造：直接接管 V 的数据区；V 的元素位于其内嵌缓冲区时只能逐个搬迁
+    Vector(Vector&& V) noexcept
+        : _size(V._size), _capacity(V._capacity), _elem(V._elem), _alloc(std::move(V._alloc)), _autoShrink(V._autoShrink) {
+        if (_elem && _elem == V._inline) {
+            _elem = allocate(_capacity);
+            relocate(_elem, V._elem, _size);
+        }
+        V.reset();
+    }
 
     // 析构函数
-    ~Vector() { delete[] _elem; }
+    ~Vector() {
+        destroy(0, _size);
+        release(_elem, _capacity);
+    }
+
+    // 返回分配器
+    Alloc get_allocator() const { return _alloc; }
 
     // 只读接口
     Rank size() const { return _size; }  // 返回向量的规模
 
+    int capacity() const { return _capacity; }  // 返回向量的容量
+
     bool empty() const { return !_size; }  // 判断向量是否为空
 
     // 判断向量是否已排序
-    int disordered() const {
-        int n = 0;
-        for (Rank i = 1; i < _size; i++)
-            if (_elem[i - 1] > _elem[i]) n++;
-        return n;
-    }
+    int disordered() const { return scanDisordered(_elem, _size); }
 
     // 无序向量整体查找
     Rank find(T const& e) const { return find(e, 0, _size); }
 
     // 无序向量区间查找
-    Rank find(T const& e, Rank lo, Rank hi) const {
-        while ((lo < hi--) && (_elem[hi] != e));
-        return hi;
-    }
+    Rank find(T const& e, Rank lo, Rank hi) const { return scanFind(_elem, e, lo, hi); }
+
+    // 统计等于 e 的元素个数
+    int count(T const& e) const { return count(e, 0, _size); }
+    int count(T const& e, Rank lo, Rank hi) const { return scanCount(_elem, e, lo, hi); }
+
+    // 区间中首个最大、最小元素的秩（区间非空）
+    Rank max(Rank lo, Rank hi) const { return scanMax(_elem, lo, hi); }
+    Rank min(Rank lo, Rank hi) const { return scanMin(_elem, lo, hi); }
 
     // 有序向量整体查找
     Rank search(T const& e) const { return (0 >= _size) ? -1 : search(e, 0, _size); }
@@ -182,15 +552,38 @@ public:
     T& operator[](Rank r) const { return _elem[r]; }  // 重载下标操作符，可以类似于数组形式引用元素
 
     // 重载赋值操作符
-    Vector<T>& operator=(Vector<T> const& V) {
-        if (_elem) delete[] _elem;  // 释放原有内容
+    Vector& operator=(Vector const& V) {
+        if (this == &V) return *this;
+        destroy(0, _size);
+        release(_elem, _capacity);  // 释放原有内容
         copyFrom(V._elem, 0, V._size);  // 复制新的内容
         return *this;
     }
 
+    // 移动赋值：释放原有内容后接管 V 的数据区；分配器不同且不随移动传递，或 V 的元素位于其内嵌缓冲区时，只能逐个移动元素
+    Vector& operator=(Vector&& V) noexcept(AllocTraits::propagate_on_container_move_assignment::value) {
+        if (this == &V) return *this;
+        destroy(0, _size);
+        release(_elem, _capacity);
+        bool sameAlloc = AllocTraits::propagate_on_container_move_assignment::value || _alloc == V._alloc;
+        if (!sameAlloc || (V._elem && V._elem == V._inline)) {
+            acquire(V._capacity);
+            relocate(_elem, V._elem, _size = V._size);
+            V._size = 0;
+            return *this;
+        }
+        if (AllocTraits::propagate_on_container_move_assignment::value) _alloc = std::move(V._alloc);
+        _elem = V._elem;
+        _size = V._size;
+        _capacity = V._capacity;
+        _autoShrink = V._autoShrink;
+        V.reset();
+        return *this;
+    }
+
     // 删除秩为 r 的元素
     T remove(Rank r) {
-        T e = _elem[r];
+        T e = std::move(_elem[r]);
         remove(r, r + 1);
         return e;
     }
@@ -198,28 +591,134 @@ public:
     // 删除区间 [lo, hi) 之内的元素
     int remove(Rank lo, Rank hi) {
         if (lo == hi) return 0;
-        while (hi < _size) _elem[lo++] = _elem[hi++];
+        while (hi < _size) _elem[lo++] = std::move(_elem[hi++]);
+        destroy(lo, _size);  // 析构尾部已被移走的元素
         _size = lo;
         shrink();  // 缩容
         return hi - lo;
     }
 
-    // 插入元素
-    Rank insert(Rank r, T const& e) {
+    // 在秩 r 处就地构造新元素
+    template <typename... Args>
+    Rank emplace(Rank r, Args&&... args) {
+        if (r == _size) {
+            emplace_back(std::forward<Args>(args)...);
+            return r;
+        }
+        T e(std::forward<Args>(args)...);  // 先构造，参数可能引用本向量内的元素
         expand();  // 如有必要，扩容
-        for (Rank i = _size; i > r; i--) _elem[i] = _elem[i - 1];
-        _elem[r] = e;
+        new (_elem + _size) T(std::move(_elem[_size - 1]));  // 末元素后移到原始空间
+        for (Rank i = _size - 1; i > r; i--) _elem[i] = std::move(_elem[i - 1]);
+        _elem[r] = std::move(e);
         _size++;
         return r;
     }
-    Rank insert(T const& e) { return insert(_size, e); }  // 默认作为末元素插入
+
+    // 在末尾就地构造新元素
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (_size < _capacity) {
+            new (_elem + _size) T(std::forward<Args>(args)...);
+        } else {
+            int c = std::max(_capacity, DEFAULT_CAPACITY) << 1;  // 与 expand() 相同的加倍策略
+            T* newElem = allocate(c);
+            new (newElem + _size) T(std::forward<Args>(args)...);  // 先构造新元素，参数可能引用原数据区
+            relocate(newElem, _elem, _size);
+            release(_elem, _capacity);
+            _elem = newElem;
+            _capacity = c;
+        }
+        return _elem[_size++];
+    }
+
+    // 插入元素
+    Rank insert(Rank r, T const& e) { return emplace(r, e); }
+    Rank insert(Rank r, T&& e) { return emplace(r, std::move(e)); }
+    Rank insert(T const& e) { emplace_back(e); return _size - 1; }  // 默认作为末元素插入
+    Rank insert(T&& e) { emplace_back(std::move(e)); return _size - 1; }
+
+    // 在秩 r 处插入区间 [first, last) 内的全部元素：至多扩容一次，后缀只整体后移一次
+    // [first, last) 不得指向本向量自身
+    template <typename It, typename = typename std::iterator_traits<It>::iterator_category>
+    Rank insert(Rank r, It first, It last) {
+        int n = (int)std::distance(first, last);
+        if (n <= 0) return r;
+        if (_size + n > _capacity) {  // 直接按所需容量申请新空间，新元素与前后缀一次就位
+            int c = std::max(_size + n, std::max(_capacity, DEFAULT_CAPACITY) << 1);
+            T* newElem = allocate(c);
+            std::uninitialized_copy(first, last, newElem + r);
+            relocate(newElem, _elem, r);
+            relocate(newElem + r + n, _elem + r, _size - r);
+            release(_elem, _capacity);
+            _elem = newElem;
+            _capacity = c;
+        } else {
+            for (Rank i = _size - 1; i >= r; i--)  // 后缀整体后移 n 位，落入原始空间者移动构造，其余移动赋值
+                if (i + n >= _size) new (_elem + i + n) T(std::move(_elem[i]));
+                else _elem[i + n] = std::move(_elem[i]);
+            for (Rank i = r; i < r + n; i++, ++first)
+                if (i < _size) _elem[i] = *first;
+                else new (_elem + i) T(*first);
+        }
+        _size += n;
+        return r;
+    }
+
+    // 删除满足条件 pred 的全部元素，一趟压缩，返回被删除的元素数
+    template <typename Pred>
+    int remove_if(Pred pred) {
+        int oldSize = _size;
+        Rank k = 0;  // [0, k) 为保留的元素
+        for (Rank i = 0; i < _size; i++) {
+            if (pred(_elem[i])) continue;
+            if (k != i) _elem[k] = std::move(_elem[i]);
+            k++;
+        }
+        destroy(k, _size);
+        _size = k;
+        shrink();
+        return oldSize - _size;
+    }
+
+    // 预留至少 c 个元素的容量，并停止自动缩容
+    void reserve(int c) {
+        _autoShrink = false;
+        if (c > _capacity) reallocate(c);
+    }
+
+    // 将容量收缩到恰好容纳现有元素，并停止自动缩容
+    void shrink_to_fit() {
+        _autoShrink = false;
+        if (_capacity > _size) reallocate(_size);
+    }
+
+    // 恢复或关闭装填因子过小时的自动缩容
+    void setAutoShrink(bool on) { _autoShrink = on; }
     
-    // 对 [lo, hi) 排序
-    void sort(Rank lo, Rank hi) { mergeSort(lo, hi); }
+    // 对 [lo, hi) 排序，默认使用自适应归并排序
+    void sort(Rank lo, Rank hi) { adaptiveSort(lo, hi); }
+
+    // 以指定算法对 [lo, hi) 排序
+    void sort(Rank lo, Rank hi, SortMethod method) {
+        switch (method) {
+            case BUBBLE_SORT: bubbleSort(lo, hi); break;
+            case SELECTION_SORT: selectionSort(lo, hi); break;
+            case MERGE_SORT: mergeSort(lo, hi); break;
+            case QUICK_SORT: quickSort(lo, hi); break;
+            case HEAP_SORT: heapSort(lo, hi); break;
+            default: adaptiveSort(lo, hi); break;
+        }
+    }
 
     // 整体排序
     void sort() { sort(0, _size); }
 
+    // 按执行策略对 [lo, hi) 多线程排序（稳定）；元素类型的比较与移动须可在多个线程上同时进行
+    void sort(Rank lo, Rank hi, ExecutionPolicy const& policy) { parallelSort(lo, hi, policy); }
+
+    // 按执行策略整体排序
+    void sort(ExecutionPolicy const& policy) { sort(0, _size, policy); }
+
     // 对 [lo, hi) 置乱
     void unsort(Rank lo, Rank hi) {
         for (Rank i = hi - lo; i > 0; i--) std::swap(_elem[lo + i - 1], _elem[lo + rand() % i]);
@@ -228,21 +727,53 @@ public:
     // 整体置乱
     void unsort() { unsort(0, _size); }
 
-    // 无序去重
-    int deduplicate() {
+    // 无序去重：保留各元素的首次出现，T 可散列时用散列表，否则逐个扫描
+    int deduplicate() { return deduplicate(IsHashable<T>()); }
+
+    // 扫描去重：在已保留的前缀中查找，O(n^2) 次比较，但一趟压缩只需 O(n) 次移动
+    int scanDeduplicate() {
         int oldSize = _size;
-        Rank i = 1;
-        while (i < _size)
-            (find(_elem[i], 0, i) < 0) ? i++ : remove(i);
+        Rank k = 0;  // [0, k) 为已保留的元素
+        for (Rank i = 0; i < _size; i++) {
+            if (find(_elem[i], 0, k) >= 0) continue;  // 重复元素
+            if (k != i) _elem[k] = std::move(_elem[i]);
+            k++;
+        }
+        destroy(k, _size);
+        _size = k;
+        shrink();
+        return oldSize - _size;
+    }
+
+    // 散列去重：开放定址散列表记录已保留元素的秩，一趟压缩，期望 O(n)
+    int hashDeduplicate() {
+        int oldSize = _size;
+        int m = 1;
+        while (m < 2 * _size) m <<= 1;  // 装填因子不超过 50%
+        std::vector<Rank> table(m, -1);  // 各桶存放已保留元素的秩，-1 为空桶
+        Rank k = 0;  // [0, k) 为已保留的元素
+        for (Rank i = 0; i < _size; i++) {
+            unsigned long long h = (unsigned long long)std::hash<T>()(_elem[i]) * 0x9E3779B97F4A7C15ULL;  // 乘法散列打散 std::hash 的低位
+            int b = (int)(h >> 32) & (m - 1);
+            while ((table[b] >= 0) && !(_elem[table[b]] == _elem[i])) b = (b + 1) & (m - 1);  // 线性试探
+            if (table[b] >= 0) continue;  // 重复元素
+            if (k != i) _elem[k] = std::move(_elem[i]);
+            table[b] = k++;
+        }
+        destroy(k, _size);
+        _size = k;
+        shrink();
         return oldSize - _size;
     }
 
     // 有序去重
     int uniquify() {
+        if (_size < 2) return 0;
         Rank i = 0, j = 0;
         while (++j < _size)
-            if (_elem[i] != _elem[j]) _elem[++i] = _elem[j];
-        _size = ++i;
+            if (_elem[i] != _elem[j] && ++i != j) _elem[i] = std::move(_elem[j]);  // i == j 时不可自移动赋值
+        destroy(++i, _size);
+        _size = i;
         shrink();
         return j - i;
     }
@@ -258,3 +789,9 @@ public:
         for (Rank i = 0; i < _size; i++) visit(_elem[i]);
     }
 };
+
+// 删除向量中满足条件 pred 的全部元素，返回被删除的元素数
+template <typename T, typename Alloc, typename Pred>
+int erase_if(Vector<T, Alloc>& V, Pred pred) {
+    return V.remove_if(pred);
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+// 向量的顺序扫描核心：查找、计数、最大/最小元素的秩、相邻逆序对计数
+// 通用版本为模板，对任意元素类型逐个比较；int、float、double 另有同名的非模板重载（重载决议时优先），
+// 在运行时检测到 CPU 支持 AVX2 时一次比较 8 个（double 为 4 个）元素，否则退回通用版本
+
+#include <cstring>  // 为了使用 std::memcpy
+
+typedef int Rank;  // 定义Rank类型
+
+// 无序区间查找：返回 A[lo, hi) 中末个等于 e 的元素的秩，没有时返回 lo - 1
+template <typename T>
+Rank scanFind(T const* A, T const& e, Rank lo, Rank hi) {
+    while ((lo < hi--) && (A[hi] != e));
+    return hi;
+}
+
+// 统计 A[lo, hi) 中等于 e 的元素个数
+template <typename T>
+int scanCount(T const* A, T const& e, Rank lo, Rank hi) {
+    int n = 0;
+    for (; lo < hi; lo++)
+        if (A[lo] == e) n++;
+    return n;
+}
+
+// A[lo, hi) 中首个最大元素的秩
+template <typename T>
+Rank scanMax(T const* A, Rank lo, Rank hi) {
+    Rank max = lo;
+    while (++lo < hi)
+        if (A[max] < A[lo]) max = lo;  // 记录更大元素的位置
+    return max;
+}
+
+// A[lo, hi) 中首个最小元素的秩
+template <typename T>
+Rank scanMin(T const* A, Rank lo, Rank hi) {
+    Rank min = lo;
+    while (++lo < hi)
+        if (A[lo] < A[min]) min = lo;  // 记录更小元素的位置
+    return min;
+}
+
+// 统计 A[0, n) 中相邻逆序对的个数
+template <typename T>
+int scanDisordered(T const* A, Rank n) {
+    int k = 0;
+    for (Rank i = 1; i < n; i++)
+        if (A[i - 1] > A[i]) k++;
+    return k;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VECTOR_SIMD_AVX2 1
+#endif
+
+#ifdef VECTOR_SIMD_AVX2
+#include <immintrin.h>
+
+#define AVX2_TARGET __attribute__((target("avx2,popcnt")))
+
+// 运行时检测 CPU 是否支持 AVX2（只检测一次）
+inline bool cpuHasAvx2() {
+    static const bool has = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"));
+    return has;
+}
+
+// 各元素类型在 AVX2 下的基本操作：W 为每个寄存器容纳的元素数，比较结果以位掩码返回（第 i 位对应第 i 个元素）
+struct Avx2Int {
+    typedef int T;
+    typedef __m256i V;
+    static const int W = 8;
+    AVX2_TARGET static V load(T const* p) { return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p)); }
+    AVX2_TARGET static V set1(T x) { return _mm256_set1_epi32(x); }
+    AVX2_TARGET static int eq(V a, V b) { return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))); }
+    AVX2_TARGET static int gt(V a, V b) { return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(a, b))); }
+    AVX2_TARGET static V max(V a, V b) { return _mm256_max_epi32(a, b); }
+    AVX2_TARGET static V min(V a, V b) { return _mm256_min_epi32(a, b); }
+    AVX2_TARGET static int nan(V) { return 0; }  // 整数没有 NaN
+};
+
+struct Avx2Float {
+    typedef float T;
+    typedef __m256 V;
+    static const int W = 8;
+    AVX2_TARGET static V load(T const* p) { return _mm256_loadu_ps(p); }
+    AVX2_TARGET static V set1(T x) { return _mm256_set1_ps(x); }
+    AVX2_TARGET static int eq(V a, V b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+    AVX2_TARGET static int gt(V a, V b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ)); }
+    AVX2_TARGET static V max(V a, V b) { return _mm256_max_ps(a, b); }
+    AVX2_TARGET static V min(V a, V b) { return _mm256_min_ps(a, b); }
+    AVX2_TARGET static int nan(V a) { return _mm256_movemask_ps(_mm256_cmp_ps(a, a, _CMP_UNORD_Q)); }
+};
+
+struct Avx2Double {
+    typedef double T;
+    typedef __m256d V;
+    static const int W = 4;
+    AVX2_TARGET static V load(T const* p) { return _mm256_loadu_pd(p); }
+    AVX2_TARGET static V set1(T x) { return _mm256_set1_pd(x); }
+    AVX2_TARGET static int eq(V a, V b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)); }
+    AVX2_TARGET static int gt(V a, V b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GT_OQ)); }
+    AVX2_TARGET static V max(V a, V b) { return _mm256_max_pd(a, b); }
+    AVX2_TARGET static V min(V a, V b) { return _mm256_min_pd(a, b); }
+    AVX2_TARGET static int nan(V a) { return _mm256_movemask_pd(_mm256_cmp_pd(a, a, _CMP_UNORD_Q)); }
+};
+
+// 自后向前逐块比较，命中时取掩码的最高位
+template <typename K>
+AVX2_TARGET Rank avx2Find(typename K::T const* A, typename K::T e, Rank lo, Rank hi) {
+    typename K::V key = K::set1(e);
+    while (hi - lo >= K::W) {
+        hi -= K::W;
+        int m = K::eq(K::load(A + hi), key);
+        if (m) return hi + 31 - __builtin_clz(m);
+    }
+    return scanFind<typename K::T>(A, e, lo, hi);
+}
+
+template <typename K>
+AVX2_TARGET int avx2Count(typename K::T const* A, typename K::T e, Rank lo, Rank hi) {
+    typename K::V key = K::set1(e);
+    int n = 0;
+    for (; hi - lo >= K::W; lo += K::W) n += __builtin_popcount(K::eq(K::load(A + lo), key));
+    return n + scanCount<typename K::T>(A, e, lo, hi);
+}
+
+// 首个最大（isMax 为假时为最小）元素的秩：先逐块求出极值，再自前向后找到它首次出现的位置；
+// 区间中有 NaN 时比较结果依赖扫描次序，交还通用版本以保持原有语义
+template <typename K, bool isMax>
+AVX2_TARGET Rank avx2Extreme(typename K::T const* A, Rank lo, Rank hi) {
+    typedef typename K::T T;
+    if (hi - lo < 4 * K::W) return isMax ? scanMax<T>(A, lo, hi) : scanMin<T>(A, lo, hi);
+    typename K::V acc[4];  // 四路独立累积，避免受浮点 max/min 的指令延迟所限
+    int nan = 0;
+    for (int j = 0; j < 4; j++) nan |= K::nan(acc[j] = K::load(A + lo + j * K::W));
+    Rank i = lo + 4 * K::W;
+    for (; hi - i >= 4 * K::W; i += 4 * K::W)
+        for (int j = 0; j < 4; j++) {
+            typename K::V v = K::load(A + i + j * K::W);
+            nan |= K::nan(v);
+            acc[j] = isMax ? K::max(acc[j], v) : K::min(acc[j], v);
+        }
+    for (; hi - i >= K::W; i += K::W) {
+        typename K::V v = K::load(A + i);
+        nan |= K::nan(v);
+        acc[0] = isMax ? K::max(acc[0], v) : K::min(acc[0], v);
+    }
+    for (int j = 1; j < 4; j++) acc[0] = isMax ? K::max(acc[0], acc[j]) : K::min(acc[0], acc[j]);
+    if (nan) return isMax ? scanMax<T>(A, lo, hi) : scanMin<T>(A, lo, hi);
+    T lane[K::W];
+    std::memcpy(lane, &acc[0], sizeof(acc[0]));
+    T best = lane[0];
+    for (int j = 1; j < K::W; j++)
+        if (isMax ? (best < lane[j]) : (lane[j] < best)) best = lane[j];
+    for (; i < hi; i++) {
+        if (A[i] != A[i]) return isMax ? scanMax<T>(A, lo, hi) : scanMin<T>(A, lo, hi);
+        if (isMax ? (best < A[i]) : (A[i] < best)) best = A[i];
+    }
+    typename K::V key = K::set1(best);
+    for (i = lo; hi - i >= K::W; i += K::W) {
+        int m = K::eq(K::load(A + i), key);
+        if (m) return i + __builtin_ctz(m);
+    }
+    while (!(A[i] == best)) i++;
+    return i;
+}
+
+template <typename K>
+AVX2_TARGET int avx2Disordered(typename K::T const* A, Rank n) {
+    int k = 0;
+    Rank i = 1;
+    for (; n - i >= K::W; i += K::W) k += __builtin_popcount(K::gt(K::load(A + i - 1), K::load(A + i)));
+    for (; i < n; i++)
+        if (A[i - 1] > A[i]) k++;
+    return k;
+}
+
+// int、float、double 的重载：运行时分派到 AVX2 或通用版本
+#define VECTOR_SIMD_OVERLOADS(T, K)                                                                              \
+    inline Rank scanFind(T const* A, T const& e, Rank lo, Rank hi) {                                           \
+        return cpuHasAvx2() ? avx2Find<K>(A, e, lo, hi) : scanFind<T>(A, e, lo, hi);                           \
+    }                                                                                                          \
+    inline int scanCount(T const* A, T const& e, Rank lo, Rank hi) {                                           \
+        return cpuHasAvx2() ? avx2Count<K>(A, e, lo, hi) : scanCount<T>(A, e, lo, hi);                         \
+    }                                                                                                          \
+    inline Rank scanMax(T const* A, Rank lo, Rank hi) {                                                        \
+        return cpuHasAvx2() ? avx2Extreme<K, true>(A, lo, hi) : scanMax<T>(A, lo, hi);                         \
+    }                                                                                                          \
+    inline Rank scanMin(T const* A, Rank lo, Rank hi) {                                                        \
+        return cpuHasAvx2() ? avx2Extreme<K, false>(A, lo, hi) : scanMin<T>(A, lo, hi);                        \
+    }                                                                                                          \
+    inline int scanDisordered(T const* A, Rank n) {                                                            \
+        return cpuHasAvx2() ? avx2Disordered<K>(A, n) : scanDisordered<T>(A, n);                               \
+    }
+
+VECTOR_SIMD_OVERLOADS(int, Avx2Int)
+VECTOR_SIMD_OVERLOADS(float, Avx2Float)
+VECTOR_SIMD_OVERLOADS(double, Avx2Double)
+
+#undef VECTOR_SIMD_OVERLOADS
+#endif
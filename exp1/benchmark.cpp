@@ -0,0 +1,413 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "Arena.h"
+#include "EytzingerIndex.h"
+#include "MappedVector.h"
+#include "SmallVector.h"
+#include "Vector.cpp"
+
+// 全局分配计数：替换 operator new/delete，统计每个测试期间的堆分配次数
+static long long g_allocs = 0;
+
+// 禁止内联，否则编译器会把 new/delete 与 malloc/free 的配对误报为不匹配
+__attribute__((noinline)) void* operator new(std::size_t n) {
+    g_allocs++;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+__attribute__((noinline)) void operator delete(void* p) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// 带计数的元素类型：记录构造、复制和移动的次数
+struct Tracked {
+    static long long defaults, copies, moves;
+    std::string payload;
+
+    Tracked() { defaults++; }
+    Tracked(std::string const& s) : payload(s) {}
+    Tracked(Tracked const& t) : payload(t.payload) { copies++; }
+    Tracked(Tracked&& t) noexcept : payload(std::move(t.payload)) { moves++; }
+    Tracked& operator=(Tracked const& t) { payload = t.payload; copies++; return *this; }
+    Tracked& operator=(Tracked&& t) noexcept { payload = std::move(t.payload); moves++; return *this; }
+
+    static void reset() { defaults = copies = moves = 0; }
+};
+long long Tracked::defaults = 0, Tracked::copies = 0, Tracked::moves = 0;
+
+// 旧版增长路径的复现：new T[] 默认构造全部空位，扩容时逐个复制赋值
+template <typename T>
+class LegacyVector {
+    int _size, _capacity;
+    T* _elem;
+
+    void expand() {
+        if (_size < _capacity) return;
+        _capacity = std::max(_capacity, DEFAULT_CAPACITY);
+        T* oldElem = _elem;
+        _elem = new T[_capacity <<= 1];
+        for (int i = 0; i < _size; i++) _elem[i] = oldElem[i];
+        delete[] oldElem;
+    }
+
+public:
+    LegacyVector() : _size(0), _capacity(DEFAULT_CAPACITY), _elem(new T[DEFAULT_CAPACITY]) {}
+    ~LegacyVector() { delete[] _elem; }
+    void insert(T const& e) {
+        expand();
+        _elem[_size++] = e;
+    }
+};
+
+// 计时并打印一次测试的结果
+template <typename F>
+void measure(char const* name, F run) {
+    Tracked::reset();
+    long long allocs = g_allocs;
+    auto start = std::chrono::steady_clock::now();
+    run();
+    auto end = std::chrono::steady_clock::now();
+    std::cout << std::left << std::setw(34) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << std::chrono::duration<double, std::milli>(end - start).count() << " ms"
+              << std::setw(12) << (g_allocs - allocs) << " allocs"
+              << std::setw(12) << Tracked::defaults << " default"
+              << std::setw(12) << Tracked::copies << " copies"
+              << std::setw(12) << Tracked::moves << " moves\n";
+}
+
+// 尾部插入密集型负载：旧增长路径 vs. 原始空间 + 移动搬迁
+void benchmarkGrowth(int n) {
+    std::cout << "== push-heavy growth, n = " << n << " ==\n";
+    std::string text(40, 'x');  // 超出短字符串优化，每个字符串都有自己的堆空间
+
+    measure("LegacyVector<int>::insert", [&] { LegacyVector<int> v; for (int i = 0; i < n; i++) v.insert(i); });
+    measure("Vector<int>::insert", [&] { Vector<int> v; for (int i = 0; i < n; i++) v.insert(i); });
+
+    measure("LegacyVector<string>::insert", [&] { LegacyVector<std::string> v; for (int i = 0; i < n; i++) v.insert(text); });
+    measure("Vector<string>::insert", [&] { Vector<std::string> v; for (int i = 0; i < n; i++) v.insert(text); });
+    measure("Vector<string>::emplace_back", [&] { Vector<std::string> v; for (int i = 0; i < n; i++) v.emplace_back(40, 'x'); });
+
+    measure("LegacyVector<Tracked>::insert", [&] { LegacyVector<Tracked> v; for (int i = 0; i < n; i++) v.insert(Tracked(text)); });
+    measure("Vector<Tracked>::insert", [&] { Vector<Tracked> v; for (int i = 0; i < n; i++) v.insert(Tracked(text)); });
+    measure("Vector<Tracked>::emplace_back", [&] { Vector<Tracked> v; for (int i = 0; i < n; i++) v.emplace_back(text); });
+    std::cout << "\n";
+}
+
+// 请求级短命向量：每个批次创建大量小向量，批次结束后全部丢弃
+template <typename V, typename Make, typename EndBatch>
+void runBatches(int batches, int perBatch, int len, Make make, EndBatch endBatch) {
+    std::vector<V> live;
+    live.reserve(perBatch);
+    for (int b = 0; b < batches; b++) {
+        for (int i = 0; i < perBatch; i++) {
+            live.push_back(make());
+            V& v = live.back();
+            for (int k = 0; k < len; k++) v.insert((k * 7919 + i) % 1000);
+            v.sort();
+        }
+        live.clear();
+        endBatch();
+    }
+}
+
+// 默认分配器 vs. Arena：比较堆分配次数与耗时
+void benchmarkArena(int batches, int perBatch, int len) {
+    std::cout << "== short-lived vectors, " << batches << " batches x " << perBatch << " vectors x " << len << " ints ==\n";
+    measure("Vector<int> (global heap)", [&] {
+        runBatches<Vector<int>>(batches, perBatch, len, [] { return Vector<int>(); }, [] {});
+    });
+    Arena arena;
+    measure("Vector<int, ArenaAllocator>", [&] {
+        typedef Vector<int, ArenaAllocator<int>> ArenaVector;
+        runBatches<ArenaVector>(batches, perBatch, len,
+                                [&] { return ArenaVector(ArenaAllocator<int>(arena)); }, [&] { arena.reset(); });
+    });
+    std::cout << "arena blocks requested from the heap: " << arena.blocks() << "\n\n";
+}
+
+// 生成不同有序程度的测试数据
+std::vector<int> makeInput(std::string const& kind, int n) {
+    std::vector<int> a(n);
+    for (int i = 0; i < n; i++) a[i] = rand();
+    if (kind == "random") return a;
+    if (kind == "sorted runs") {  // 16 个各自有序的分段依次拼接，模拟多路数据源的汇入
+        for (int lo = 0; lo < n; lo += n / 16) std::sort(a.begin() + lo, a.begin() + std::min(n, lo + n / 16));
+        return a;
+    }
+    std::sort(a.begin(), a.end());
+    if (kind == "reversed") std::reverse(a.begin(), a.end());
+    if (kind == "nearly sorted")  // 1% 的元素被随机交换
+        for (int i = 0; i < n / 100; i++) std::swap(a[rand() % n], a[rand() % n]);
+    if (kind == "sorted + tail") for (int i = n - n / 100; i < n; i++) a[i] = rand();  // 有序数据后追加少量新记录
+    if (kind == "few unique") for (int i = 0; i < n; i++) a[i] %= 16;
+    return a;
+}
+
+// 各排序算法在不同输入上的耗时
+void benchmarkSort(int n) {
+    std::cout << "== Vector<int>::sort, n = " << n << " (ms) ==\n";
+    char const* kinds[] = {"random", "sorted", "reversed", "nearly sorted", "sorted runs", "sorted + tail", "few unique"};
+    SortMethod methods[] = {MERGE_SORT, QUICK_SORT, HEAP_SORT, ADAPTIVE_SORT};
+    char const* names[] = {"merge", "quick", "heap", "adaptive"};
+    std::cout << std::left << std::setw(16) << "input" << std::right;
+    for (char const* name : names) std::cout << std::setw(12) << name;
+    std::cout << std::setw(12) << "std::stable" << "\n";
+    for (char const* kind : kinds) {
+        std::vector<int> input = makeInput(kind, n);
+        std::cout << std::left << std::setw(16) << kind << std::right << std::fixed << std::setprecision(2);
+        for (SortMethod m : methods) {
+            if (m == QUICK_SORT && std::string(kind) == "few unique") {  // 大量重复元素时快速排序退化为平方复杂度
+                std::cout << std::setw(12) << "-";
+                continue;
+            }
+            Vector<int> v(input.data(), n);
+            auto start = std::chrono::steady_clock::now();
+            v.sort(0, n, m);
+            auto end = std::chrono::steady_clock::now();
+            std::cout << std::setw(12) << std::chrono::duration<double, std::milli>(end - start).count();
+        }
+        std::vector<int> w = input;
+        auto start = std::chrono::steady_clock::now();
+        std::stable_sort(w.begin(), w.end());
+        auto end = std::chrono::steady_clock::now();
+        std::cout << std::setw(12) << std::chrono::duration<double, std::milli>(end - start).count() << "\n";
+    }
+    std::cout << "\n";
+}
+
+// 多线程排序随线程数的扩展情况
+void benchmarkParallelSort(int n, int maxThreads) {
+    std::cout << "== Vector<int>::sort(ExecutionPolicy), n = " << n << ", hardware threads = "
+              << std::thread::hardware_concurrency() << " ==\n";
+    std::vector<int> input = makeInput("random", n);
+    double base = 0;
+    for (int threads = 1; threads <= maxThreads; threads <<= 1) {
+        Vector<int> v(input.data(), n);
+        auto start = std::chrono::steady_clock::now();
+        v.sort(ExecutionPolicy(threads));
+        auto end = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (threads == 1) base = ms;
+        std::cout << std::setw(4) << threads << " threads" << std::fixed << std::setprecision(2) << std::setw(12) << ms
+                  << " ms" << std::setw(10) << base / ms << "x\n";
+    }
+    std::cout << "\n";
+}
+
+// 原先的无序去重：逐个在前缀中查找，重复者调用 remove(i) 整体前移
+template <typename T>
+int legacyDeduplicate(Vector<T>& v) {
+    int oldSize = v.size();
+    Rank i = 1;
+    while (i < v.size())
+        if (v.find(v[i], 0, i) < 0) i++;
+        else v.remove(i);
+    return oldSize - v.size();
+}
+
+// 去重耗时：原实现、扫描压缩、散列；平方复杂度的实现在规模过大时按 10^5 的实测值外推
+void benchmarkDeduplicate(bool full) {
+    std::cout << "== Vector<int>::deduplicate, values drawn from [0, n/2) (ms) ==\n";
+    std::cout << std::setw(10) << "n" << std::setw(14) << "legacy" << std::setw(14) << "scan" << std::setw(14) << "hash" << "\n";
+    double legacyBase = 0, scanBase = 0;
+    for (int n = 10000; n <= 1000000; n *= 10) {
+        std::vector<int> input(n);
+        for (int i = 0; i < n; i++) input[i] = rand() % (n / 2);
+        auto time = [&](int (*run)(Vector<int>&)) {
+            Vector<int> v(input.data(), n);
+            auto start = std::chrono::steady_clock::now();
+            run(v);
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+        bool quadratic = full || n <= 100000;
+        double legacy = quadratic ? time([](Vector<int>& v) { return legacyDeduplicate(v); }) : legacyBase * (n / 100000.0) * (n / 100000.0);
+        double scan = quadratic ? time([](Vector<int>& v) { return v.scanDeduplicate(); }) : scanBase * (n / 100000.0) * (n / 100000.0);
+        double hash = time([](Vector<int>& v) { return v.hashDeduplicate(); });
+        if (n == 100000) legacyBase = legacy, scanBase = scan;
+        std::cout << std::fixed << std::setprecision(2) << std::setw(10) << n << std::setw(13) << legacy << (quadratic ? " " : "*")
+                  << std::setw(13) << scan << (quadratic ? " " : "*") << std::setw(14) << hash << "\n";
+    }
+    if (!full) std::cout << "(* extrapolated from n = 100000; run with 'dedup-full' to measure)\n";
+    std::cout << "\n";
+}
+
+// 有序向量查找吞吐：Vector::search() vs. EytzingerIndex 的单个与批量查找（百万次查找/秒）
+void benchmarkSearch(long long maxN) {
+    std::cout << "== sorted Vector<int> lookup throughput (M lookups/s) ==\n";
+    std::cout << std::setw(12) << "n" << std::setw(14) << "search()" << std::setw(14) << "eytzinger" << std::setw(14) << "search_many" << "\n";
+    const int m = 4000000;
+    std::vector<int> queries(m);
+    std::vector<Rank> out(m);
+    for (long long n = 1000; n <= maxN; n *= 10) {
+        Vector<int> v((int)n);
+        for (int i = 0; i < n; i++) v.insert(2 * i);  // 偶数，查询中一半落在两元素之间
+        EytzingerIndex<int> index(v);
+        for (int i = 0; i < m; i++) queries[i] = (int)(((long long)rand() * RAND_MAX + rand()) % (2 * n + 2)) - 1;
+        long long check[3] = {0, 0, 0};
+        auto rate = [&](int which) {
+            auto start = std::chrono::steady_clock::now();
+            if (which == 0) for (int i = 0; i < m; i++) check[0] += v.search(queries[i]);
+            if (which == 1) for (int i = 0; i < m; i++) check[1] += index.search(queries[i]);
+            if (which == 2) {
+                index.search_many(queries.data(), m, out.data());
+                for (int i = 0; i < m; i++) check[2] += out[i];
+            }
+            return m / std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        };
+        double r0 = rate(0), r1 = rate(1), r2 = rate(2);
+        std::cout << std::fixed << std::setprecision(2) << std::setw(12) << n << std::setw(14) << r0 << std::setw(14) << r1
+                  << std::setw(14) << r2 << (check[0] == check[1] && check[1] == check[2] ? "" : "  MISMATCH") << "\n";
+    }
+    std::cout << "\n";
+}
+
+// 大量小向量：邻接表（同时存活）与短命的临时列表，元素数均为 1 ~ 8
+template <typename V>
+long long runAdjacency(int n) {
+    std::vector<V> adj;
+    adj.reserve(n);
+    for (int i = 0; i < n; i++) {
+        adj.emplace_back();
+        for (int k = 0, d = i % 8 + 1; k < d; k++) adj.back().insert((i + k * 7919) % n);
+    }
+    long long sum = 0;
+    for (int i = 0; i < n; i++)
+        for (Rank k = 0; k < adj[i].size(); k++) sum += adj[adj[i][k]].size();  // 访问邻居的规模，模拟图遍历的间接访问
+    return sum;
+}
+
+template <typename V>
+long long runTemporaries(int n) {
+    long long sum = 0;
+    for (int i = 0; i < n; i++) {
+        V tokens;
+        for (int k = 0, d = i % 8 + 1; k < d; k++) tokens.insert(i ^ k);
+        sum += tokens[tokens.max(0, tokens.size())];
+    }
+    return sum;
+}
+
+// Vector vs. SmallVector：堆分配次数与耗时
+void benchmarkSmallVector(int n) {
+    std::cout << "== tiny vectors, " << n << " adjacency lists / " << 5 * n << " temporaries, 1-8 ints each ==\n";
+    long long check[3];
+    measure("adjacency Vector<int>", [&] { check[0] = runAdjacency<Vector<int>>(n); });
+    measure("adjacency SmallVector<int, 8>", [&] { check[1] = runAdjacency<SmallVector<int, 8>>(n); });
+    measure("adjacency SmallVector<int, 4>", [&] { check[2] = runAdjacency<SmallVector<int, 4>>(n); });
+    if (check[0] != check[1] || check[1] != check[2]) std::cout << "MISMATCH\n";
+    measure("temporaries Vector<int>", [&] { check[0] = runTemporaries<Vector<int>>(5 * n); });
+    measure("temporaries SmallVector<int, 8>", [&] { check[1] = runTemporaries<SmallVector<int, 8>>(5 * n); });
+    measure("temporaries SmallVector<int, 4>", [&] { check[2] = runTemporaries<SmallVector<int, 4>>(5 * n); });
+    if (check[0] != check[1] || check[1] != check[2]) std::cout << "MISMATCH\n";
+    std::cout << "\n";
+}
+
+// 启动加载：从二进制文件逐个读入并插入 Vector vs. 直接映射已有的 MappedVector 文件，随后各做 10^6 次查找；
+// 映射区的页面在首次访问时才从文件（或页缓存）调入，这部分代价计入查找
+void benchmarkMapped(int n) {
+    std::cout << "== loading a sorted dataset of " << n << " ints (" << (long long)n * sizeof(int) / (1 << 20) << " MB) ==\n";
+    char const* rawPath = "bench_raw.bin";
+    char const* mappedPath = "bench_mapped.bin";
+    {  // 准备数据：同样的有序整数分别写成裸二进制文件与 MappedVector 文件
+        std::vector<int> chunk(1 << 20);
+        FILE* raw = std::fopen(rawPath, "wb");
+        MappedVector<int> mv(mappedPath, MAPPED_CREATE);
+        for (int lo = 0; lo < n; lo += (int)chunk.size()) {
+            int m = std::min((int)chunk.size(), n - lo);
+            for (int i = 0; i < m; i++) chunk[i] = 2 * (lo + i);
+            std::fwrite(chunk.data(), sizeof(int), m, raw);
+            mv.append(chunk.data(), m);
+        }
+        std::fclose(raw);
+        mv.shrink_to_fit();
+    }
+    const int m = 1000000;
+    std::vector<int> queries(m);
+    for (int i = 0; i < m; i++) queries[i] = (int)(((long long)rand() * RAND_MAX + rand()) % (2LL * n));
+    long long check[2] = {0, 0};
+    {
+        Vector<int> v;
+        measure("read + insert into Vector<int>", [&] {
+            FILE* raw = std::fopen(rawPath, "rb");
+            std::vector<int> chunk(1 << 16);
+            for (std::size_t got; (got = std::fread(chunk.data(), sizeof(int), chunk.size(), raw)) > 0;)
+                for (std::size_t i = 0; i < got; i++) v.insert(chunk[i]);
+            std::fclose(raw);
+        });
+        measure("  then 10^6 searches", [&] { for (int i = 0; i < m; i++) check[0] += v.search(queries[i]); });
+    }
+    {
+        MappedVector<int>* v = nullptr;
+        measure("open MappedVector<int>", [&] { v = new MappedVector<int>(mappedPath, MAPPED_READ_ONLY); });
+        measure("  then 10^6 searches (page-in)", [&] { for (int i = 0; i < m; i++) check[1] += v->search(queries[i]); });
+        delete v;
+    }
+    if (check[0] != check[1]) std::cout << "MISMATCH\n";
+    std::remove(rawPath);
+    std::remove(mappedPath);
+    std::cout << "\n";
+}
+
+// 顺序扫描带宽：通用模板（逐个比较）vs. 运行时分派后的版本（AVX2 可用时），单位 GB/s
+template <typename T>
+void benchmarkScanType(char const* name, int n) {
+    std::vector<T> A(n);
+    for (int i = 0; i < n; i++) A[i] = (T)(rand() % 1000000);
+    T absent = (T)-1;  // 不在数组中，find() 扫描整个区间
+    int reps = (int)std::max(1LL, (1LL << 30) / ((long long)n * (long long)sizeof(T)));  // 每项约扫描 1 GB
+    long long sink = 0;
+    auto rate = [&](auto run) {
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < reps; r++) sink += run();
+        double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return (double)n * sizeof(T) * reps / s / 1e9;
+    };
+    T const* a = A.data();
+    double r[10] = {
+        rate([&] { return scanFind<T>(a, absent, 0, n); }),  rate([&] { return scanFind(a, absent, 0, n); }),
+        rate([&] { return scanCount<T>(a, a[n / 2], 0, n); }), rate([&] { return scanCount(a, a[n / 2], 0, n); }),
+        rate([&] { return scanMax<T>(a, 0, n); }),            rate([&] { return scanMax(a, 0, n); }),
+        rate([&] { return scanMin<T>(a, 0, n); }),            rate([&] { return scanMin(a, 0, n); }),
+        rate([&] { return scanDisordered<T>(a, n); }),        rate([&] { return scanDisordered(a, n); }),
+    };
+    bool same = scanFind<T>(a, absent, 0, n) == scanFind(a, absent, 0, n) && scanCount<T>(a, a[n / 2], 0, n) == scanCount(a, a[n / 2], 0, n)
+             && scanMax<T>(a, 0, n) == scanMax(a, 0, n) && scanMin<T>(a, 0, n) == scanMin(a, 0, n)
+             && scanDisordered<T>(a, n) == scanDisordered(a, n);
+    std::cout << std::setw(8) << name << std::setw(10) << n << std::fixed << std::setprecision(2);
+    for (int i = 0; i < 10; i += 2) std::cout << std::setw(8) << r[i] << " /" << std::setw(6) << r[i + 1];
+    std::cout << (same ? "" : "  MISMATCH") << (sink == 42 ? " " : "") << "\n";
+}
+
+void benchmarkScan() {
+    std::cout << "== Vector scan kernels, scalar / dispatched (GB/s) ==\n";
+    std::cout << std::setw(8) << "type" << std::setw(10) << "n" << std::setw(16) << "find" << std::setw(16) << "count"
+              << std::setw(16) << "max" << std::setw(16) << "min" << std::setw(16) << "disordered" << "\n";
+    for (int n : {4096, 16 << 20}) {  // 缓存内与远超缓存两种规模
+        benchmarkScanType<int>("int", n);
+        benchmarkScanType<float>("float", n);
+        benchmarkScanType<double>("double", n);
+    }
+    std::cout << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::string which = argc > 1 ? argv[1] : "all";
+    if (which == "all" || which == "growth") benchmarkGrowth(1000000);
+    if (which == "all" || which == "arena") benchmarkArena(1000, 2000, 24);
+    if (which == "all" || which == "sort") benchmarkSort(2000000);
+    if (which == "all" || which == "dedup" || which == "dedup-full") benchmarkDeduplicate(which == "dedup-full");
+    if (which == "all" || which == "search") benchmarkSearch(100000000);
+    if (which == "all" || which == "parallel")
+        benchmarkParallelSort(20000000, (int)std::max(8u, std::thread::hardware_concurrency()));
+    if (which == "all" || which == "simd") benchmarkScan();
+    if (which == "all" || which == "small") benchmarkSmallVector(2000000);
+    if (which == "all" || which == "mapped") benchmarkMapped(1 << 27);
+    return 0;
+}
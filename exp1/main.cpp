@@ -6,29 +6,13 @@
 #include <string>
 #include <iomanip> 
 #include <random>     
+#include <utility>
 
-class Complex {
-public:
-    double real;  // 实部
-    double imag;  // 虚部
-
-    Complex(double r = 0.0, double i = 0.0) : real(r), imag(i) {}
-
-    // 计算复数的模
-    double modulus() const {
-        return std::sqrt(real * real + imag * imag);
-    }
-
-    // 重载相等运算符，用于查找
-    bool operator==(const Complex& other) const {
-        return real == other.real && imag == other.imag;
-    }
-
-    // 用于打印复数
-    void print() const {
-        std::cout << real << " + " << imag << "i";
-    }
-};
+#include "Complex.h"
+#include "ComplexColumns.h"
+#include "ModulusIndex.h"
+#include "SortByKey.h"
+#include "Vector.cpp"
 
 // 用于比较两个复数的模，若模相同则比较实部
 bool compareByModulus(const Complex& a, const Complex& b) {
@@ -40,6 +24,16 @@ bool compareByModulus(const Complex& a, const Complex& b) {
     return modA < modB;
 }
 
+// 与 compareByModulus 等价的排序键：(模, 实部) 按字典序比较
+std::pair<double, double> modulusKey(const Complex& c) {
+    return std::make_pair(c.modulus(), c.real);
+}
+
+// 按模排序（模相同时按实部），每个元素只开方一次
+void sortByModulus(std::vector<Complex>& vec) {
+    sort_by_key(vec.begin(), vec.end(), modulusKey);
+}
+
 std::vector<Complex> generateRandomComplexVector(int n) {
     std::vector<Complex> vec;
     srand((unsigned)time(0));  // 设置随机数种子
@@ -92,6 +86,21 @@ void testVectorOperations(std::vector<Complex>& vec) {
     std::cout << "Vector has been uniquified.\n";
 }
 
+// 测试 Vector::uniquify 对非平凡类型（std::string）的去重：相邻且互不相同的元素不得被自移动清空
+bool testVectorUniquify() {
+    const char* words[] = {"alpha", "beta", "beta", "gamma", "gamma", "gamma", "delta"};
+    Vector<std::string> v;
+    for (const char* w : words) v.insert(w);
+    int removed = v.uniquify();
+    const char* expected[] = {"alpha", "beta", "gamma", "delta"};
+    bool ok = removed == 3 && v.size() == 4;
+    for (int i = 0; ok && i < 4; i++) ok = v[i] == expected[i];
+    std::cout << "Vector<string>::uniquify:";
+    for (int i = 0; i < v.size(); i++) std::cout << " \"" << v[i] << "\"";
+    std::cout << (ok ? "  (ok)" : "  (FAILED)") << "\n";
+    return ok;
+}
+
 void bubbleSort(std::vector<Complex>& vec) {
     for (size_t i = 0; i < vec.size(); ++i) {
         for (size_t j = 0; j < vec.size() - i - 1; ++j) {
@@ -128,6 +137,30 @@ void testSortingEfficiency(const std::vector<Complex>& vec, const std::string& d
               << (double)(end - start) / CLOCKS_PER_SEC << " seconds\n";
 }
 
+// 比较逐次计算模的排序与缓存键的排序
+void testKeyedSortEfficiency(int n) {
+    std::vector<Complex> vec = generateRandomComplexVector(n);
+    std::vector<Complex> vec1 = vec, vec2 = vec, vec3 = vec;
+
+    clock_t start = clock();
+    mergeSort(vec1, 0, vec1.size());
+    double mergeTime = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    std::sort(vec2.begin(), vec2.end(), compareByModulus);
+    double stdTime = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    sortByModulus(vec3);
+    double keyedTime = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    bool ok = std::is_sorted(vec3.begin(), vec3.end(), compareByModulus);
+    std::streamsize precision = std::cout.precision();
+    std::cout << std::setw(10) << n << std::fixed << std::setprecision(4) << std::setw(14) << mergeTime << std::setw(14)
+              << stdTime << std::setw(14) << keyedTime << std::setw(10) << std::setprecision(2) << stdTime / keyedTime << "x"
+              << (ok ? "" : "  NOT SORTED") << "\n" << std::setprecision(precision);
+}
+
 std::vector<Complex> findInRange(const std::vector<Complex>& vec, double m1, double m2) {
     std::vector<Complex> result;
     for (const auto& c : vec) {
@@ -139,6 +172,91 @@ std::vector<Complex> findInRange(const std::vector<Complex>& vec, double m1, dou
     return result;
 }
 
+// 比较行式存储上的逐个计算与列式存储上的批量计算：reps 轮求全部模、查找不存在的值、按模筛选
+void testColumnsEfficiency(int n, int reps) {
+    std::vector<Complex> vec = generateRandomComplexVector(n);
+    ComplexColumns cols(vec);
+    std::vector<double> mod(n);
+    Complex absent(100.0, 100.0);
+    double sink = 0;
+    double rowTime[3], colTime[3];
+
+    clock_t start = clock();
+    for (int r = 0; r < reps; r++) {
+        for (int i = 0; i < n; i++) mod[i] = vec[i].modulus();
+        sink += mod[r % n];
+    }
+    rowTime[0] = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (int r = 0; r < reps; r++) {
+        cols.modulus(mod.data());
+        sink += mod[r % n];
+    }
+    colTime[0] = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (int r = 0; r < reps; r++) sink += std::find(vec.begin(), vec.end(), absent) - vec.begin();
+    rowTime[1] = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (int r = 0; r < reps; r++) sink += cols.find(absent);
+    colTime[1] = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    size_t rowCount = 0, colCount = 0;
+    start = clock();
+    for (int r = 0; r < reps; r++) rowCount += findInRange(vec, 1.0, 5.0).size();
+    rowTime[2] = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (int r = 0; r < reps; r++) colCount += cols.findInRange(1.0, 5.0).size();
+    colTime[2] = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    std::streamsize precision = std::cout.precision();
+    const char* names[3] = {"modulus", "find (absent)", "findInRange [1, 5)"};
+    for (int k = 0; k < 3; k++)
+        std::cout << std::setw(20) << names[k] << std::fixed << std::setprecision(4) << std::setw(12) << rowTime[k]
+                  << std::setw(12) << colTime[k] << std::setw(9) << std::setprecision(2) << rowTime[k] / colTime[k] << "x\n";
+    std::cout << std::setprecision(precision) << (rowCount == colCount && sink != -1 ? "" : "MISMATCH\n");
+}
+
+// 比较逐个扫描的 findInRange() 与 ModulusIndex 的单个、成批查询
+void testModulusIndexEfficiency(int n, int q) {
+    std::vector<Complex> vec = generateRandomComplexVector(n);
+    std::vector<Complex> sortedVec = vec;
+    sortByModulus(sortedVec);
+    ModulusIndex index(vec);
+    std::vector<double> m1(q), m2(q);
+    for (int i = 0; i < q; i++) {
+        m1[i] = (rand() % 1500) / 100.0;
+        m2[i] = m1[i] + (rand() % 100) / 100.0;
+    }
+
+    int scanQueries = q / 1000 > 0 ? q / 1000 : 1;  // 扫描太慢，只做一小部分
+    bool ok = true;
+    clock_t start = clock();
+    for (int i = 0; i < scanQueries; i++) {
+        std::vector<Complex> result = findInRange(sortedVec, m1[i], m2[i]);
+        ComplexSpan span = index.range(m1[i], m2[i]);
+        ok = ok && (int)result.size() == span.size();
+        for (int k = 0; ok && k < span.size(); k++) ok = compareByModulus(result[k], span[k]) == compareByModulus(span[k], result[k]);
+    }
+    double scanRate = scanQueries / ((double)(clock() - start) / CLOCKS_PER_SEC);
+
+    long long total = 0;
+    start = clock();
+    for (int i = 0; i < q; i++) total += index.range(m1[i], m2[i]).size();
+    double singleRate = q / ((double)(clock() - start) / CLOCKS_PER_SEC);
+
+    std::vector<ComplexSpan> spans(q);
+    start = clock();
+    index.range(m1.data(), m2.data(), q, spans.data());
+    double batchRate = q / ((double)(clock() - start) / CLOCKS_PER_SEC);
+    for (int i = 0; i < q; i++) total -= spans[i].size();
+
+    std::streamsize precision = std::cout.precision();
+    std::cout << std::fixed << std::setprecision(0) << "findInRange scan: " << scanRate << ", index: " << singleRate
+              << ", batched index: " << batchRate << (ok && total == 0 ? "" : "  MISMATCH") << "\n"
+              << std::setprecision(precision);
+}
+
 int main() {
     // 增加向量的规模到 10,000
     std::vector<Complex> vec = generateRandomComplexVector(10000);
@@ -158,6 +276,7 @@ int main() {
     // 测试各种操作
     std::cout << "Testing vector operations:\n";
     testVectorOperations(vec);
+    bool uniquifyOk = testVectorUniquify();
 
     // 测试排序效率 - 顺序向量
     std::cout << "\nTesting sorting efficiency for sorted vector:\n";
@@ -171,6 +290,22 @@ int main() {
     std::cout << "\nTesting sorting efficiency for reversed vector:\n";
     testSortingEfficiency(reverseVec, "Reversed Vector");
 
+    // 测试缓存键排序的效率
+    std::cout << "\nTesting key-cached sort by modulus (seconds):\n";
+    std::cout << std::setw(10) << "n" << std::setw(14) << "merge sort" << std::setw(14) << "std::sort" << std::setw(14)
+              << "sort_by_key" << std::setw(11) << "speedup" << "\n";
+    for (int n = 10000; n <= 10000000; n *= 10) testKeyedSortEfficiency(n);
+
+    // 测试列式存储的批量运算效率
+    std::cout << "\nTesting column store, 10^4 complex numbers x 10^4 rounds and 10^6 x 100 (seconds):\n";
+    std::cout << std::setw(20) << "" << std::setw(12) << "rows" << std::setw(12) << "columns" << std::setw(10) << "speedup" << "\n";
+    testColumnsEfficiency(10000, 10000);
+    testColumnsEfficiency(1000000, 100);
+
+    // 测试有序模索引的区间查询效率
+    std::cout << "\nTesting modulus index range queries on 10^6 complex numbers (queries per second):\n";
+    testModulusIndexEfficiency(1000000, 100000);
+
     // 区间查找
     double m1 = 1.0, m2 = 5.0;
     std::vector<Complex> result = findInRange(sortedVec, m1, m2);
@@ -180,5 +315,5 @@ int main() {
         std::cout << "\n";
     }
 
-    return 0;
+    return uniquifyOk ? 0 : 1;
 }
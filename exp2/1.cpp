@@ -6,9 +6,17 @@
 #include <sstream>
 #include <stdexcept>
 #include <cctype>
+#include <chrono>
+#include <iomanip>
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Expression.h"
+#include "ExpressionStream.h"
 
-const int N_OPTR = 9; 
-const char operators[] = {'+', '-', '*', '/', '^', '!', '(', ')', '#'}; 
 std::map<char, int> opIndex;
 
 // ʼ
@@ -24,30 +32,6 @@ void initializeOpIndex() {
     opIndex.insert(std::make_pair('#', 8));
 }
 
-// 鱾4.6ȼ
-char priorityTable[N_OPTR][N_OPTR] = {
-    // +   -   *   /   ^   !   (   )   #
-    {'>', '>', '<', '<', '<', '<', '<', '>', '>'}, // +
-    {'>', '>', '<', '<', '<', '<', '<', '>', '>'}, // -
-    {'>', '>', '>', '>', '<', '<', '<', '>', '>'}, // *
-    {'>', '>', '>', '>', '<', '<', '<', '>', '>'}, // /
-    {'>', '>', '>', '>', '>', '<', '<', '>', '>'}, // ^
-    {'>', '>', '>', '>', '>', '>', ' ', '>', '>'}, // !
-    {'<', '<', '<', '<', '<', '<', '<', '=', ' '}, // (
-    {'>', '>', '>', '>', '>', '>', ' ', '>', '>'}, // )
-    {'<', '<', '<', '<', '<', '<', '<', ' ', '='}  // #
-};
-
-// Զ׳˺
-double factorial(int n) {
-    if (n <= 1) return 1;
-    double result = 1;
-    for (int i = 2; i <= n; ++i) {
-        result *= i;
-    }
-    return result;
-}
-
 double stringToDouble(const std::string& s) {
     std::stringstream ss(s);
     double result;
@@ -159,7 +143,183 @@ double evaluate(const std::string& expression) {
     return valStack.top();
 }
 
-int main() {
+// ͬһʽֵÿ½ evaluate() vs. һκ󷴸ֵ
+void testCompiledEfficiency(const std::string& expression, int times) {
+    auto start = std::chrono::steady_clock::now();
+    double sum1 = 0;
+    for (int i = 0; i < times; i++) sum1 += evaluate(expression);
+    double parsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    Expression compiled(expression);
+    double sum2 = 0;
+    for (int i = 0; i < times; i++) sum2 += compiled.evaluate();
+    double once = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::left << std::setw(24) << expression << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << times / parsed / 1e6 << std::setw(12) << times / once / 1e6 << std::setw(9)
+              << parsed / once << "x" << (sum1 == sum2 ? "" : "  MISMATCH") << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+// ıʽһΣͬıȡֵֵ
+void testVariableEfficiency(const std::string& expression, int times) {
+    Expression compiled(expression, {"x", "y"});
+    std::vector<double> xs(1024), ys(1024);
+    for (int i = 0; i < 1024; i++) xs[i] = i * 0.01, ys[i] = 1 + i * 0.02;
+    double vars[2], sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < times; i++) {
+        vars[0] = xs[i & 1023];
+        vars[1] = ys[i & 1023];
+        sum += compiled.evaluate(vars);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::left << std::setw(24) << expression << std::right << std::fixed << std::setprecision(2) << std::setw(12)
+              << "-" << std::setw(12) << times / seconds / 1e6 << (sum == sum ? "" : "  NaN") << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+// ֵ£е evaluate() vs. гֵ/룩
+void testBatchEfficiency(const std::string& expression, int rows, int rounds) {
+    Expression compiled(expression, {"x", "y"});
+    std::vector<double> xs(rows), ys(rows), out1(rows), out2(rows);
+    for (int i = 0; i < rows; i++) xs[i] = 0.5 + (i % 1000) * 0.01, ys[i] = 1 + (i % 777) * 0.02;
+    double vars[2];
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++)
+        for (int i = 0; i < rows; i++) {
+            vars[0] = xs[i];
+            vars[1] = ys[i];
+            out1[i] = compiled.evaluate(vars);
+        }
+    double perRow = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const double* columns[2] = {xs.data(), ys.data()};
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) compiled.evaluate(columns, rows, out2.data());
+    double batch = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::left << std::setw(28) << expression << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << (double)rows * rounds / perRow / 1e6 << std::setw(12) << (double)rows * rounds / batch / 1e6
+              << std::setw(9) << perRow / batch << "x" << (out1 == out2 ? "" : "  MISMATCH") << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+// Żǰֵٶȣ/룩
+void testOptimizedEfficiency(const std::string& expression, int times) {
+    Expression plain(expression, {"x", "y"});
+    Expression optimized(expression, {"x", "y"});
+    optimized.optimize();
+    std::vector<double> xs(1024), ys(1024);
+    for (int i = 0; i < 1024; i++) xs[i] = 0.5 + i * 0.01, ys[i] = 1 + i * 0.02;
+    double vars[2], sum1 = 0, sum2 = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < times; i++) {
+        vars[0] = xs[i & 1023];
+        vars[1] = ys[i & 1023];
+        sum1 += plain.evaluate(vars);
+    }
+    double before = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < times; i++) {
+        vars[0] = xs[i & 1023];
+        vars[1] = ys[i & 1023];
+        sum2 += optimized.evaluate(vars);
+    }
+    double after = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::left << std::setw(32) << expression << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << times / before / 1e6 << std::setw(12) << times / after / 1e6 << std::setw(9)
+              << before / after << "x" << std::setw(6) << plain.code().size() << " -> " << optimized.code().size()
+              << (std::fabs(sum1 - sum2) <= 1e-9 * std::fabs(sum1) ? "" : "  MISMATCH") << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+// ֵĹʽÿζ vs.  LRU ȡ/룩
+// distinct ͬĹʽ hot ֵƵΪ capacity
+void testCacheEfficiency(int distinct, int hot, int capacity, int times) {
+    std::vector<std::string> formulas;
+    for (int i = 0; i < distinct; i++)
+        formulas.push_back("(x+" + std::to_string(i) + ")*(x-y)/(x*y+1)+sin(" + std::to_string(i % 7) + ")*y^2");
+    std::vector<int> order(times);
+    unsigned seed = 12345;
+    for (int i = 0; i < times; i++) {
+        seed = seed * 1103515245 + 12345;
+        order[i] = (seed >> 8) % 10 < 9 ? (int)((seed >> 12) % hot) : (int)((seed >> 12) % distinct);  // ųȵ
+    }
+    double vars[2] = {1.5, 2.5}, sum1 = 0, sum2 = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < times; i++) {
+        Expression f(formulas[order[i]]);
+        sum1 += f.evaluate(vars);
+    }
+    double compile = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ExpressionCache cache(capacity);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < times; i++) sum2 += cache.get(formulas[order[i]])->evaluate(vars);
+    double cached = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::setw(8) << distinct << std::setw(8) << hot << std::setw(10) << capacity << std::fixed
+              << std::setprecision(2) << std::setw(12) << times / compile / 1e6 << std::setw(12) << times / cached / 1e6
+              << std::setw(9) << compile / cached << "x" << std::setw(9) << 100.0 * cache.hits() / times << "%"
+              << (std::fabs(sum1 - sum2) <= 1e-9 * std::fabs(sum1) ? "" : "  MISMATCH") << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+// ʽֵ£ lines бʽֵͬ߳/룩߳Ӧ뵥߳ȫͬ
+void testStreamEfficiency(int lines) {
+    static const char* forms[] = {"%d+%d*%d", "(%d+%d)*(%d-1)/7", "sin(%d)+cos(%d)*%d", "log(%d+1)*%d^2-%d",
+                                  "%d!/(%d+1)+%d", "((%d-3)*(%d+4))^2/(%d+1)"};
+    std::string input;
+    char line[64];
+    for (int i = 0; i < lines; i++) {
+        std::snprintf(line, sizeof(line), forms[i % 6], i % 97, i % 13 + 1, i % 10);
+        input += line;
+        input += '\n';
+    }
+    std::string expected;
+    for (int threads = 1; threads <= 8; threads *= 2) {
+        std::istringstream in(input);
+        std::ostringstream out;
+        auto start = std::chrono::steady_clock::now();
+        StreamStats stats = evaluateStream(in, out, threads);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (threads == 1) expected = out.str();
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(2) << std::setw(12)
+                  << stats.lines / seconds / 1e6 << std::setw(10) << stats.errors
+                  << (stats.lines == lines && out.str() == expected ? "" : "  MISMATCH") << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << std::setprecision(6);
+    }
+}
+
+// ʽģʽ1 input [output] [threads]ֵ inputд outputȱʡΪ׼
+int evaluateFile(int argc, char* argv[]) {
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in) {
+        std::cerr << "Error: cannot open " << argv[1] << std::endl;
+        return 1;
+    }
+    std::ofstream file;
+    if (argc > 2) file.open(argv[2], std::ios::binary);
+    std::ostream& out = argc > 2 ? file : std::cout;
+    int threads = argc > 3 ? std::atoi(argv[3]) : (int)std::thread::hardware_concurrency();
+    auto start = std::chrono::steady_clock::now();
+    StreamStats stats = evaluateStream(in, out, threads);
+    out.flush();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << stats.lines << " lines (" << stats.errors << " errors) in " << seconds << " s, "
+              << stats.lines / seconds << " lines/s, " << threads << " threads" << std::endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) return evaluateFile(argc, argv);
+
     initializeOpIndex(); 
 
     // 
@@ -176,10 +336,63 @@ int main() {
         std::cout << "Test 10 (8/(4-2)+sin(1)): " << evaluate("8/(4-2)+sin(1)") << std::endl;  // 8/2 + sin(1)
         std::cout << "Test 11 (cos(0) + 10/2): " << evaluate("cos(0) + 10/2") << std::endl;  // cos(0) + 5 = 6
         std::cout << "Test 12 (3 + 4! + log(1)): " << evaluate("3+4!+log(1)") << std::endl;  //  27
+
+        // ֵ {x, y} Ĵ
+        Expression f("x*2+sin(y)", {"x", "y"});
+        double vars[2] = {1.5, 0.5};
+        std::cout << "Test 13 (x*2+sin(y), x=1.5, y=0.5): " << f.evaluate(vars) << "  [" << f.postfix() << "]" << std::endl;
+        vars[0] = 3;
+        std::cout << "Test 14 (x*2+sin(y), x=3, y=0.5): " << f.evaluate(vars) << std::endl;
+        Expression g("log(x^2+1)*cos(x/(y+1))!", {"x", "y"});
+        std::cout << "Test 15 (log(x^2+1)*cos(x/(y+1))!): " << g.evaluate(vars) << "  [" << g.postfix() << "]" << std::endl;
+        Expression h("sin(0.5)*x+(x+y)^2+(x+y)*3+5!", {"x", "y"});
+        h.optimize();  // ۵x^2 Ϊ˷x+y ֻһ
+        std::cout << "Test 16 (sin(0.5)*x+(x+y)^2+(x+y)*3+5!): " << h.evaluate(vars) << "  [" << h.postfix() << "]" << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
     }
 
+    // Чʲԣֵ/룩
+    std::cout << "\n" << std::left << std::setw(24) << "expression" << std::right << std::setw(12) << "evaluate()"
+              << std::setw(12) << "compiled" << std::setw(10) << "speedup" << std::endl;
+    testCompiledEfficiency("3+5*2", 2000000);
+    testCompiledEfficiency("10+(2*3)^2", 2000000);
+    testCompiledEfficiency("sin(0.5)+cos(0.5)", 2000000);
+    testCompiledEfficiency("7^2 - 3*2 + 4/2", 2000000);
+    testCompiledEfficiency("3+4!+log(1)", 2000000);
+    testVariableEfficiency("x*2+sin(y)", 10000000);
+    testVariableEfficiency("(x+y)*(x-y)/(x*y+1)", 10000000);
+
+    // ֵ/룩
+    std::cout << "\n" << std::left << std::setw(28) << "expression (10^6 rows)" << std::right << std::setw(12) << "per row"
+              << std::setw(12) << "batched" << std::setw(10) << "speedup" << std::endl;
+    testBatchEfficiency("(x+y)*(x-y)/(x*y+1)", 1000000, 10);
+    testBatchEfficiency("x*2+y*3-x/y", 1000000, 10);
+    testBatchEfficiency("x^2+y^2", 1000000, 10);
+    testBatchEfficiency("x*2+sin(y)", 1000000, 10);
+    testBatchEfficiency("log(x+1)*cos(y)", 1000000, 10);
+
+    // Żǰ󣨰ֵ/룩ָ
+    std::cout << "\n" << std::left << std::setw(32) << "expression" << std::right << std::setw(12) << "compiled"
+              << std::setw(12) << "optimized" << std::setw(10) << "speedup" << std::setw(12) << "code" << std::endl;
+    testOptimizedEfficiency("sin(0.5)*x+cos(0.5)*y", 10000000);
+    testOptimizedEfficiency("(x+y)^2+(x+y)*3", 10000000);
+    testOptimizedEfficiency("10!/x+log(2)^3*y", 10000000);
+    testOptimizedEfficiency("sin(x*y)*cos(x*y)+sin(x*y)", 10000000);
+    testOptimizedEfficiency("x*2+sin(y)", 10000000);
+
+    // ʽ棨/룩
+    std::cout << "\n" << std::setw(8) << "formulas" << std::setw(8) << "hot" << std::setw(10) << "capacity"
+              << std::setw(12) << "compile" << std::setw(12) << "cached" << std::setw(10) << "speedup" << std::setw(10)
+              << "hits" << std::endl;
+    testCacheEfficiency(100, 100, 256, 1000000);
+    testCacheEfficiency(10000, 100, 256, 1000000);
+    testCacheEfficiency(10000, 1000, 256, 1000000);
+
+    // ʽֵ10^6 У/룩
+    std::cout << "\n" << std::setw(8) << "threads" << std::setw(12) << "Mlines/s" << std::setw(10) << "errors" << std::endl;
+    testStreamEfficiency(1000000);
+
     return 0;
 }
 
@@ -4,11 +4,15 @@
 #include <algorithm>
 #include <ctime>
 #include <cstdlib>
+#include <chrono>
+#include <iomanip>
+
+#include "LargestRectangle.h"
 
 // ֱͼĺ
-int largestArea(const std::vector<int>& heights) {
+long long largestArea(const std::vector<int>& heights) {
     std::stack<int> s;  // ڴջ
-    int maxArea = 0;    // ʼΪ 0
+    long long maxArea = 0;  // ʼΪ 0 64 λ
     int n = heights.size();
     for (int i = 0; i <= n; i++) {
         int h = (i == n) ? 0 : heights[i];
@@ -16,7 +20,7 @@ int largestArea(const std::vector<int>& heights) {
             int height = heights[s.top()];
             s.pop();
             int width = s.empty() ? i : i - s.top() - 1;
-            maxArea = std::max(maxArea, height * width);
+            maxArea = std::max(maxArea, (long long)height * width);
         }
         s.push(i);
     }
@@ -43,7 +47,114 @@ void print(const std::vector<int>& heights) {
     }
     std::cout << "]" << std::endl;
 }
-int main() {
+// ֱͼ largestArea() vs. 㣨ֱͼ/룩
+void testBatchEfficiency(int count, int maxLength, int maxHeight) {
+    std::vector<long long> offsets(count + 1);
+    offsets[0] = 0;
+    for (int i = 0; i < count; i++) offsets[i + 1] = offsets[i] + rand() % maxLength + 1;
+    std::vector<int> heights(offsets[count]);
+    for (size_t i = 0; i < heights.size(); i++) heights[i] = rand() % (maxHeight + 1);
+
+    std::vector<long long> expected(count);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++) {
+        std::vector<int> h(heights.begin() + offsets[i], heights.begin() + offsets[i + 1]);
+        expected[i] = largestArea(h);
+    }
+    double perCall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::setw(10) << count << std::setw(8) << maxLength << std::fixed << std::setprecision(2) << std::setw(12)
+              << count / perCall / 1e6;
+    for (int threads = 1; threads <= 8; threads *= 2) {
+        std::vector<long long> areas(count);
+        start = std::chrono::steady_clock::now();
+        largestAreas(heights.data(), offsets.data(), count, areas.data(), threads);
+        double batch = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << std::setw(10) << count / batch / 1e6 << (areas == expected ? "" : "!");
+    }
+    std::cout << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+// ռդȫ 1 Ӿ󣺰ͬ߳㣨/룩߳ĽӦͬ
+void testMaximalRectangle(int rows, int cols, int percent) {
+    BitMatrix m(rows, cols);
+    for (int r = 0; r < rows; r++)
+        for (int c = 0; c < cols; c++)
+            if (rand() % 100 < percent) m.set(r, c);
+    MaximalRectangle first;
+    std::cout << std::setw(7) << rows << " x " << std::left << std::setw(7) << cols << std::right << std::setw(5) << percent
+              << "%";
+    for (int threads = 1; threads <= 8; threads *= 2) {
+        auto start = std::chrono::steady_clock::now();
+        MaximalRectangle best = maximalRectangle(m, threads);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (threads == 1) first = best;
+        bool same = best.area == first.area && best.top == first.top && best.left == first.left;
+        std::cout << std::fixed << std::setprecision(1) << std::setw(10) << (double)rows * cols / seconds / 1e6
+                  << (same ? "" : "!");
+    }
+    std::cout << "   area " << first.area << " (" << first.height << " x " << first.width << " at " << first.top << ", "
+              << first.left << ")" << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+// ʽΣ/룩ֻÿ󶼲ѯһΣԱÿ interval Իȫ¼
+void testStreamEfficiency(int samples, int maxHeight, int interval) {
+    std::vector<int> heights(samples);
+    for (int i = 0; i < samples; i++) heights[i] = rand() % (maxHeight + 1);
+
+    LargestRectangleStream pushOnly;
+    auto start = std::chrono::steady_clock::now();
+    pushOnly.push(heights.data(), samples);
+    double pushSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    LargestRectangleStream stream;
+    long long last = 0;
+    int depth = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < samples; i++) {
+        stream.push(heights[i]);
+        last = stream.max();
+        depth = std::max(depth, stream.depth());
+    }
+    double querySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<int> stack(samples + 1);
+    long long recomputed = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = interval; i <= samples; i += interval) recomputed = largestAreaKernel(heights.data(), i, stack.data());
+    double recomputeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    int rounds = samples / interval;
+    bool same = pushOnly.max() == last && (samples % interval != 0 || recomputed == last);
+
+    std::cout << std::setw(10) << samples << std::setw(10) << maxHeight << std::fixed << std::setprecision(2) << std::setw(12)
+              << samples / pushSeconds / 1e6 << std::setw(12) << samples / querySeconds / 1e6 << std::setw(14)
+              << (double)rounds * interval / recomputeSeconds / 1e6 << std::setw(8) << depth << "   area " << last
+              << (same ? "" : "  MISMATCH") << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+int main(int argc, char* argv[]) {
+    // ָļʱȫ 1 Ӿ2 matrix.txt [threads]
+    if (argc > 1) {
+        try {
+            BitMatrix m = BitMatrix::load(argv[1]);
+            auto start = std::chrono::steady_clock::now();
+            MaximalRectangle best = maximalRectangle(m, argc > 2 ? std::atoi(argv[2]) : 0);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << m.rows() << " x " << m.cols() << ": area " << best.area << " (" << best.height << " x "
+                      << best.width << " at row " << best.top << ", column " << best.left << "), " << seconds << " s"
+                      << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
     // 
     srand(static_cast<unsigned>(time(0)));
     //  10 ݲ
@@ -56,6 +167,44 @@ int main() {
         print(randomHeights);
         std::cout << ": " << largestArea(randomHeights) << std::endl;
     }
+
+    // ߶Ⱥܴʱ int ķΧ
+    std::vector<int> tall(3, 2000000000);
+    std::cout << "߶: heights = [2000000000, 2000000000, 2000000000]" << std::endl;
+    std::cout << ": " << largestArea(tall) << std::endl;
+
+    // 㣨ֱͼ/룩 ! ʾĽ
+    std::cout << "\n" << std::setw(10) << "count" << std::setw(8) << "length" << std::setw(12) << "per call"
+              << std::setw(10) << "1 thread" << std::setw(10) << "2" << std::setw(10) << "4" << std::setw(10) << "8"
+              << std::endl;
+    testBatchEfficiency(2000000, 16, 104);
+    testBatchEfficiency(1000000, 64, 104);
+    testBatchEfficiency(100000, 1000, 1000000);
+
+    // ȫ 1 Ӿ󣨰/룬Ϊ 1248 ̣߳ ! ʾ뵥̵߳Ľ
+    std::cout << "\n" << std::setw(22) << "matrix" << std::setw(10) << "1 thread" << std::setw(10) << "2" << std::setw(10)
+              << "4" << std::setw(10) << "8" << std::endl;
+    testMaximalRectangle(4096, 4096, 90);
+    testMaximalRectangle(16384, 16384, 97);
+    testMaximalRectangle(1000, 50000, 99);
+
+    // ʽΣΪֻ롢ѯÿ 10^6 ¼һ飨ƣ/룩
+    std::cout << "\n" << std::setw(10) << "samples" << std::setw(10) << "height" << std::setw(12) << "push" << std::setw(12)
+              << "push+max" << std::setw(14) << "recompute" << std::setw(8) << "depth" << std::endl;
+    testStreamEfficiency(10000000, 104, 1000000);
+    testStreamEfficiency(10000000, 1000000, 1000000);
+
+    // ڣ 8 
+    LargestRectangleStream window(8);
+    std::vector<int> series = generateRandomHeights(20, 104);
+    std::cout << "\n (8): heights = ";
+    print(series);
+    std::cout << ":";
+    for (int h : series) {
+        window.push(h);
+        std::cout << " " << window.max();
+    }
+    std::cout << std::endl;
     return 0;
 }
 
@@ -0,0 +1,599 @@
+#pragma once
+
+#include <cctype>         // Ϊʹ std::isdigit, std::isalpha
+#include <charconv>       // Ϊʹ std::from_chars, std::to_chars
+#include <cmath>          // Ϊʹ std::pow, std::sin, std::cos, std::log
+#include <cstdint>        // Ϊʹ std::uint64_t
+#include <cstring>        // Ϊʹ std::memcpy
+#include <list>           // Ϊʹ std::list
+#include <map>            // Ϊʹ std::map
+#include <memory>         // Ϊʹ std::shared_ptr
+#include <stdexcept>      // Ϊʹ std::invalid_argument
+#include <string>         // Ϊʹ std::string
+#include <string_view>    // Ϊʹ std::string_view
+#include <tuple>          // Ϊʹ std::tuple
+#include <unordered_map>  // Ϊʹ std::unordered_map
+#include <utility>        // Ϊʹ std::pair
+#include <vector>         // Ϊʹ std::vector
+
+const int N_OPTR = 9;
+const char operators[] = {'+', '-', '*', '/', '^', '!', '(', ')', '#'};
+
+// 鱾4.6ȼջУ뵱ǰУȼϵ
+const char priorityTable[N_OPTR][N_OPTR] = {
+    // +   -   *   /   ^   !   (   )   #
+    {'>', '>', '<', '<', '<', '<', '<', '>', '>'}, // +
+    {'>', '>', '<', '<', '<', '<', '<', '>', '>'}, // -
+    {'>', '>', '>', '>', '<', '<', '<', '>', '>'}, // *
+    {'>', '>', '>', '>', '<', '<', '<', '>', '>'}, // /
+    {'>', '>', '>', '>', '>', '<', '<', '>', '>'}, // ^
+    {'>', '>', '>', '>', '>', '>', ' ', '>', '>'}, // !
+    {'<', '<', '<', '<', '<', '<', '<', '=', ' '}, // (
+    {'>', '>', '>', '>', '>', '>', ' ', '>', '>'}, // )
+    {'<', '<', '<', '<', '<', '<', '<', ' ', '='}  // #
+};
+
+// ȼе±꣬ʱ -1
+inline int operatorIndex(char op) {
+    for (int i = 0; i < N_OPTR; i++)
+        if (operators[i] == op) return i;
+    return -1;
+}
+
+// ׳˱171! ѳ double ķΧ n Ľ׳˶
+const int FACTORIAL_TABLE_SIZE = 171;
+
+// Զ׳˺۳˵ĴԤѭ۳˵Ľͬ
+inline double factorial(int n) {
+    static const struct Table {
+        double v[FACTORIAL_TABLE_SIZE];
+        Table() {
+            v[0] = 1;
+            for (int i = 1; i < FACTORIAL_TABLE_SIZE; i++) v[i] = v[i - 1] * i;
+        }
+    } table;
+    if (n <= 1) return 1;
+    return n < FACTORIAL_TABLE_SIZE ? table.v[n] : HUGE_VAL;
+}
+
+// ׺ֽĲ
+enum OpCode : unsigned char {
+    OP_CONST,  // ѹ볣
+    OP_VAR,    // ѹ
+    OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_POW,  // Ԫ
+    OP_FACT,                                 // ׳ˣ׺һԪ㣩
+    OP_SIN, OP_COS, OP_LOG,                  // 
+    OP_NONE,   // ͨţӦ
+    OP_LOAD,   // ѹʱеֵӱʽ
+    OP_STORE   // ջֵʱۣջ
+};
+
+// һָֵıָţֵʱٲ
+struct Instr {
+    OpCode op;
+    int var;       // OP_VAR ıţ OP_LOADOP_STORE ʱ۱
+    double value;  // OP_CONST ֵ
+};
+
+// ֵ㣨һԪֻ aڳ۵ֵ߽
+inline double applyOp(OpCode op, double a, double b) {
+    switch (op) {
+        case OP_ADD: return a + b;
+        case OP_SUB: return a - b;
+        case OP_MUL: return a * b;
+        case OP_DIV: return a / b;
+        case OP_POW: return std::pow(a, b);
+        case OP_FACT: return factorial(static_cast<int>(a));
+        case OP_SIN: return std::sin(a);
+        case OP_COS: return std::cos(a);
+        case OP_LOG: return std::log(a);
+        default: return a;
+    }
+}
+
+// ֵʱÿ
+const int EXPR_BLOCK = 256;
+
+// һִһ㣺o[j] = a[j] op b[j]һԪֻ aj = 0, 1, ..., EXPR_BLOCK - 1o  a ͬ
+// GCC 㰴 4  double һдɱӳ䵽ǰָʱ⵽ AVX2 ʱ AVX2 汾
+// pow׳ǡñ׼
+#if defined(__GNUC__)
+typedef double ExprVec __attribute__((vector_size(32)));
+#define EXPR_BLOCK_BINARY(a, b, o, expr)                          \
+    for (int j = 0; j < EXPR_BLOCK; j += 4) {                     \
+        ExprVec x, y;                                             \
+        std::memcpy(&x, a + j, sizeof(x));                        \
+        std::memcpy(&y, b + j, sizeof(y));                        \
+        ExprVec z = expr;                                         \
+        std::memcpy(o + j, &z, sizeof(z));                        \
+    }
+#else
+#define EXPR_BLOCK_BINARY(a, b, o, expr)                          \
+    for (int j = 0; j < EXPR_BLOCK; j++) {                        \
+        double x = a[j], y = b[j];                                \
+        o[j] = expr;                                              \
+    }
+#endif
+
+#define EXPR_BLOCK_KERNEL(name, attr)                                                          \
+    attr inline void name(OpCode op, double* o, double const* a, double const* b) {          \
+        switch (op) {                                                                          \
+            case OP_ADD: EXPR_BLOCK_BINARY(a, b, o, x + y) break;                              \
+            case OP_SUB: EXPR_BLOCK_BINARY(a, b, o, x - y) break;                              \
+            case OP_MUL: EXPR_BLOCK_BINARY(a, b, o, x * y) break;                              \
+            case OP_DIV: EXPR_BLOCK_BINARY(a, b, o, x / y) break;                              \
+            case OP_POW: for (int j = 0; j < EXPR_BLOCK; j++) o[j] = std::pow(a[j], b[j]); break; \
+            case OP_FACT: for (int j = 0; j < EXPR_BLOCK; j++) o[j] = factorial(static_cast<int>(a[j])); break; \
+            case OP_SIN: for (int j = 0; j < EXPR_BLOCK; j++) o[j] = std::sin(a[j]); break;    \
+            case OP_COS: for (int j = 0; j < EXPR_BLOCK; j++) o[j] = std::cos(a[j]); break;    \
+            case OP_LOG: for (int j = 0; j < EXPR_BLOCK; j++) o[j] = std::log(a[j]); break;    \
+            default: break;                                                                    \
+        }                                                                                      \
+    }
+
+EXPR_BLOCK_KERNEL(blockKernel, )
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+EXPR_BLOCK_KERNEL(blockKernelAvx2, __attribute__((target("avx2"))))
+#define EXPR_HAS_AVX2_KERNEL 1
+#endif
+#undef EXPR_BLOCK_KERNEL
+#undef EXPR_BLOCK_BINARY
+
+typedef void (*ExprBlockKernel)(OpCode, double*, double const*, double const*);
+
+// ǰ CPU Ͽõ汾ֻһΣ
+inline ExprBlockKernel exprBlockKernel() {
+#ifdef EXPR_HAS_AVX2_KERNEL
+    static const ExprBlockKernel k = (__builtin_cpu_init(), __builtin_cpu_supports("avx2")) ? blockKernelAvx2 : blockKernel;
+    return k;
+#else
+    return blockKernel;
+#endif
+}
+
+// ʽǶޣջֵջĴС
+const int EXPR_MAX_DEPTH = 256;
+
+// ҺҲʱ OP_NONE
+inline OpCode functionCode(std::string_view name) {
+    if (name == "sin") return OP_SIN;
+    if (name == "cos") return OP_COS;
+    if (name == "log") return OP_LOG;
+    return OP_NONE;
+}
+
+// ӦĲ
+inline OpCode operatorCode(char op) {
+    switch (op) {
+        case '+': return OP_ADD;
+        case '-': return OP_SUB;
+        case '*': return OP_MUL;
+        case '/': return OP_DIV;
+        case '^': return OP_POW;
+        default: return OP_FACT;
+    }
+}
+
+inline bool isIdentStart(char c) { return std::isalpha((unsigned char)c) || c == '_'; }
+inline bool isIdentChar(char c) { return std::isalnum((unsigned char)c) || c == '_'; }
+
+// ȼ׺ʽתΪ׺ʽÿõһ sink
+// sink.constant(value) ѹ볣sink.variable(name) ѹsink.apply(op) ִ㡣
+// ʷԪΪ text ϵ string_viewջռ䣨ֻгʱ쳣Ϣ
+template <typename Sink>
+void parseExpression(std::string_view text, Sink& sink) {
+    char opStack[EXPR_MAX_DEPTH + 1];     // ջ
+    OpCode funcStack[EXPR_MAX_DEPTH + 1]; // ջ룺'(' ĺΪ OP_NONE
+    int top = 0;
+    opStack[0] = '#';
+    funcStack[0] = OP_NONE;
+    auto push = [&](char op, OpCode f) {
+        if (top == EXPR_MAX_DEPTH) throw std::invalid_argument("Expression too deep: " + std::string(text));
+        opStack[++top] = op;
+        funcStack[top] = f;
+    };
+    // ǰ ch ջ֮ǰջȼߵ
+    auto reduce = [&](char ch) {
+        int col = operatorIndex(ch);
+        while (priorityTable[operatorIndex(opStack[top])][col] == '>') sink.apply(operatorCode(opStack[top--]));
+        char rel = priorityTable[operatorIndex(opStack[top])][col];
+        if (rel == ' ') throw std::invalid_argument("Unbalanced parentheses in expression: " + std::string(text));
+        if (rel == '=') {  // ţβ '#'
+            if (funcStack[top] != OP_NONE) sink.apply(funcStack[top]);
+            top--;
+        } else {
+            push(ch, OP_NONE);
+        }
+    };
+
+    size_t i = 0, n = text.size();
+    while (i < n) {
+        char ch = text[i];
+        if (std::isspace((unsigned char)ch)) {
+            i++;
+        } else if (std::isdigit((unsigned char)ch) || ch == '.') {
+            double value = 0;
+            auto r = std::from_chars(text.data() + i, text.data() + n, value);
+            if (r.ec != std::errc()) throw std::invalid_argument("Bad number in expression: " + std::string(text));
+            sink.constant(value);
+            i = r.ptr - text.data();
+        } else if (isIdentStart(ch)) {
+            size_t j = i;
+            while (j < n && isIdentChar(text[j])) j++;
+            std::string_view name = text.substr(i, j - i);
+            size_t k = j;
+            while (k < n && std::isspace((unsigned char)text[k])) k++;
+            if (k < n && text[k] == '(') {  // ã'(' 뺯һͬջԵ ')' ʱ
+                OpCode f = functionCode(name);
+                if (f == OP_NONE) throw std::invalid_argument("Unsupported function");
+                push('(', f);
+                i = k + 1;
+            } else {
+                sink.variable(name);
+                i = j;
+            }
+        } else if (operatorIndex(ch) >= 0 && ch != '#') {
+            reduce(ch);
+            i++;
+        } else {
+            throw std::invalid_argument("Unexpected character in expression: " + std::string(text));
+        }
+    }
+    reduce('#');
+    if (top != -1) throw std::invalid_argument("Unbalanced parentheses in expression: " + std::string(text));
+}
+
+// ıʽʱȼһתΪ׺ֽ룬˺Բͬıȡֵֵ
+// ֵȲַҲռ䡣
+// ֧ + - * / ^ !šֳĸ»߿ͷıʶԼΪӱʽ sincoslog
+class Expression {
+public:
+    static const int MAX_DEPTH = EXPR_MAX_DEPTH;  // ֵջ
+
+private:
+    std::vector<Instr> _code;            // ׺ֽ
+    std::vector<std::string> _vars;      // ±꼴
+    int _depth;                          // ֵջ
+    int _slots;                          // ʱ۵ĸ
+
+    // ׷Ϊָ
+    struct Emitter {
+        Expression& e;
+        void constant(double value) { e.emit(OP_CONST, 0, value); }
+        void variable(std::string_view name) { e.emit(OP_VAR, e.addVariable(name)); }
+        void apply(OpCode op) { e.emit(op); }
+    };
+
+    // ׷һָ
+    void emit(OpCode op, int var = 0, double value = 0) { _code.push_back(Instr{op, var, value}); }
+
+    // ǼǱ
+    int addVariable(std::string_view name) {
+        int k = variable(name);
+        if (k >= 0) return k;
+        _vars.emplace_back(name);
+        return (int)_vars.size() - 1;
+    }
+
+    // ָջȵӰģ⣬
+    void verify(std::string_view text) {
+        int depth = 0;
+        _depth = 0;
+        for (Instr const& in : _code) {
+            int pops = in.op <= OP_VAR || in.op == OP_LOAD ? 0 : in.op <= OP_POW ? 2 : 1;  // OP_STORE ȡջŻ
+            if (depth < pops) throw std::invalid_argument("Missing operand in expression: " + std::string(text));
+            depth += 1 - pops;
+            if (depth > _depth) _depth = depth;
+        }
+        if (depth != 1) throw std::invalid_argument("Malformed expression: " + std::string(text));
+        if (_depth > MAX_DEPTH) throw std::invalid_argument("Expression too deep: " + std::string(text));
+    }
+
+    void compile(std::string_view text) {
+        Emitter sink{*this};
+        parseExpression(text, sink);
+        verify(text);
+    }
+
+public:
+    // ʽvariables ԤָıŴ򣬱ʽгֵαں
+    explicit Expression(std::string_view text, std::vector<std::string> const& variables = {}) : _vars(variables), _depth(0), _slots(0) {
+        compile(text);
+    }
+
+    // ±꼴ֵʱ vars еλ
+    std::vector<std::string> const& variables() const { return _vars; }
+
+    // ıţûʱ -1
+    int variable(std::string_view name) const {
+        for (size_t i = 0; i < _vars.size(); i++)
+            if (_vars[i] == name) return (int)i;
+        return -1;
+    }
+
+    // ׺ֽ
+    std::vector<Instr> const& code() const { return _code; }
+
+    // Żֽ롣ֽ뽨ʽ޻ͼͬӱʽֻͬһ㣬ͬʱ
+    //   - ȫΪֱ sin(0.5)5!
+    //   - x^1 Ϊ xx^0 Ϊ 1x^2 Ϊ x*x˷ȷģ pow żĩλ֮GCC  pow(x, 2.0) Ҳ滻
+    //     ߵָ˻ۻԵ pow
+    //   - ദõӱʽ״ʱۣOP_STOREΪȡOP_LOAD
+    //  x^2 ⣬Żǰκαȡֵֵλͬд Expression(text).optimize()
+    Expression& optimize() {
+        struct Node {
+            OpCode op;
+            int var;
+            double value;
+            int a, b;  // ĽţûʱΪ -1Сڱı
+        };
+        std::vector<Node> nodes;
+        std::map<std::tuple<int, int, std::uint64_t, int, int>, int> index;  // ͬĽֻһ
+        auto make = [&](Node const& n) {
+            std::uint64_t bits;  // λȽϣ0  -0 ϲ
+            std::memcpy(&bits, &n.value, sizeof(bits));
+            auto key = std::make_tuple((int)n.op, n.var, bits, n.a, n.b);
+            auto it = index.find(key);
+            if (it != index.end()) return it->second;
+            nodes.push_back(n);
+            index.emplace(key, (int)nodes.size() - 1);
+            return (int)nodes.size() - 1;
+        };
+        auto constant = [&](double v) { return make(Node{OP_CONST, 0, v, -1, -1}); };
+
+        std::vector<int> stack, slotNode(_slots);
+        for (Instr const& in : _code) {
+            if (in.op == OP_CONST) {
+                stack.push_back(constant(in.value));
+            } else if (in.op == OP_VAR) {
+                stack.push_back(make(Node{OP_VAR, in.var, 0, -1, -1}));
+            } else if (in.op == OP_LOAD) {
+                stack.push_back(slotNode[in.var]);
+            } else if (in.op == OP_STORE) {
+                slotNode[in.var] = stack.back();
+            } else if (in.op <= OP_POW) {
+                int b = stack.back();
+                stack.pop_back();
+                int a = stack.back();
+                bool ca = nodes[a].op == OP_CONST, cb = nodes[b].op == OP_CONST;
+                double va = nodes[a].value, vb = nodes[b].value;
+                if (ca && cb) stack.back() = constant(applyOp(in.op, va, vb));
+                else if (in.op == OP_POW && cb && vb == 2) stack.back() = make(Node{OP_MUL, 0, 0, a, a});
+                else if (in.op == OP_POW && cb && vb == 1) stack.back() = a;
+                else if (in.op == OP_POW && cb && vb == 0) stack.back() = constant(1);
+                else stack.back() = make(Node{in.op, 0, 0, a, b});
+            } else {
+                int a = stack.back();
+                if (nodes[a].op == OP_CONST) stack.back() = constant(applyOp(in.op, nodes[a].value, 0));
+                else stack.back() = make(Node{in.op, 0, 0, a, -1});
+            }
+        }
+
+        // ԸͳƸ㱻õĴıСڽ㱾ɨһ˼
+        int root = stack.back();
+        std::vector<int> uses(nodes.size(), 0);
+        uses[root] = 1;
+        for (int i = root; i >= 0; i--) {
+            if (uses[i] == 0) continue;
+            if (nodes[i].a >= 0) uses[nodes[i].a]++;
+            if (nodes[i].b >= 0) uses[nodes[i].b]++;
+        }
+
+        // ֽ루ʽջݹ飩ֱظѹ룬ռʱ
+        std::vector<Instr> code;
+        std::vector<int> slot(nodes.size(), -1);  // Ѵʱ
+        std::vector<std::pair<int, bool>> work{{root, false}};  // (, Ƿչ)
+        int slots = 0;
+        while (!work.empty()) {
+            auto [k, expanded] = work.back();
+            work.pop_back();
+            Node const& n = nodes[k];
+            if (n.op == OP_CONST || n.op == OP_VAR) {
+                code.push_back(Instr{n.op, n.var, n.value});
+            } else if (slot[k] >= 0) {
+                code.push_back(Instr{OP_LOAD, slot[k], 0});
+            } else if (!expanded) {
+                work.push_back({k, true});
+                if (n.b >= 0) work.push_back({n.b, false});
+                work.push_back({n.a, false});
+            } else {
+                code.push_back(Instr{n.op, 0, 0});
+                if (uses[k] > 1 && slots < MAX_DEPTH) {
+                    slot[k] = slots++;
+                    code.push_back(Instr{OP_STORE, slot[k], 0});
+                }
+            }
+        }
+        _code.swap(code);
+        _slots = slots;
+        verify(std::string_view());  // ջȣᳬŻ֮ǰ
+        return *this;
+    }
+
+    //  vars[0, variables().size()) ȡֵֵ
+    double evaluate(double const* vars = nullptr) const {
+        double stack[MAX_DEPTH], slots[MAX_DEPTH];
+        int top = -1;
+        for (Instr const& in : _code) {
+            switch (in.op) {
+                case OP_CONST: stack[++top] = in.value; break;
+                case OP_VAR: stack[++top] = vars[in.var]; break;
+                case OP_ADD: top--; stack[top] = stack[top] + stack[top + 1]; break;
+                case OP_SUB: top--; stack[top] = stack[top] - stack[top + 1]; break;
+                case OP_MUL: top--; stack[top] = stack[top] * stack[top + 1]; break;
+                case OP_DIV: top--; stack[top] = stack[top] / stack[top + 1]; break;
+                case OP_POW: top--; stack[top] = std::pow(stack[top], stack[top + 1]); break;
+                case OP_FACT: stack[top] = factorial(static_cast<int>(stack[top])); break;
+                case OP_SIN: stack[top] = std::sin(stack[top]); break;
+                case OP_COS: stack[top] = std::cos(stack[top]); break;
+                case OP_LOG: stack[top] = std::log(stack[top]); break;
+                case OP_LOAD: stack[++top] = slots[in.var]; break;
+                case OP_STORE: slots[in.var] = stack[top]; break;
+                default: break;
+            }
+        }
+        return stack[0];
+    }
+
+    // ֵ v ڸеȡֵΪ columns[v][0, rows)д out[0, rows)
+    // ÿ EXPR_BLOCK Ϊһ飬ÿִָһΣ͵Ŀһڵĸз̯
+    // ֱеݣֻĩβһʱŸƵÿ̱߳һݣòռ
+    void evaluate(double const* const* columns, int rows, double* out) const {
+        thread_local std::vector<double> scratch;
+        size_t blocks = (size_t)(_depth + _slots + 1);  // ջĸǰʱں
+        if (scratch.size() < blocks * EXPR_BLOCK) scratch.resize(blocks * EXPR_BLOCK);
+        double const* src[MAX_DEPTH];  // ջиݣеݻĳһ
+        ExprBlockKernel kernel = exprBlockKernel();
+        for (int base = 0; base < rows; base += EXPR_BLOCK) {
+            int len = rows - base < EXPR_BLOCK ? rows - base : EXPR_BLOCK;
+            int top = -1;
+            for (Instr const& in : _code) {
+                if (in.op == OP_CONST) {
+                    double* slot = &scratch[(size_t)++top * EXPR_BLOCK];
+                    for (int j = 0; j < EXPR_BLOCK; j++) slot[j] = in.value;
+                    src[top] = slot;
+                } else if (in.op == OP_VAR) {
+                    src[++top] = columns[in.var] + base;
+                    if (len < EXPR_BLOCK) {  // ĩ飺Ʋ룬ʹܴ
+                        double* slot = &scratch[(size_t)top * EXPR_BLOCK];
+                        std::memcpy(slot, src[top], len * sizeof(double));
+                        for (int j = len; j < EXPR_BLOCK; j++) slot[j] = 0;
+                        src[top] = slot;
+                    }
+                } else if (in.op == OP_LOAD) {
+                    src[++top] = &scratch[(size_t)(_depth + in.var) * EXPR_BLOCK];
+                } else if (in.op == OP_STORE) {
+                    std::memcpy(&scratch[(size_t)(_depth + in.var) * EXPR_BLOCK], src[top], EXPR_BLOCK * sizeof(double));
+                } else if (in.op <= OP_POW) {  // Ԫ㣺дڵĹ
+                    top--;
+                    double* slot = &scratch[(size_t)top * EXPR_BLOCK];
+                    kernel(in.op, slot, src[top], src[top + 1]);
+                    src[top] = slot;
+                } else {
+                    double* slot = &scratch[(size_t)top * EXPR_BLOCK];
+                    kernel(in.op, slot, src[top], nullptr);
+                    src[top] = slot;
+                }
+            }
+            std::memcpy(out + base, src[0], len * sizeof(double));
+        }
+    }
+
+    // ׺ʽıڲ鿴
+    std::string postfix() const {
+        static const char* names[] = {"", "", "+", "-", "*", "/", "^", "!", "sin", "cos", "log", "", "t", "=t"};
+        std::string s;
+        for (Instr const& in : _code) {
+            if (!s.empty()) s += ' ';
+            if (in.op == OP_CONST) {
+                char buf[32];
+                auto r = std::to_chars(buf, buf + sizeof(buf), in.value);
+                s.append(buf, r.ptr);
+            } else if (in.op == OP_VAR) {
+                s += _vars[in.var];
+            } else if (in.op == OP_LOAD || in.op == OP_STORE) {
+                s += names[in.op];
+                s += std::to_string(in.var);
+            } else {
+                s += names[in.op];
+            }
+        }
+        return s;
+    }
+};
+
+// ֵ߽ sinkÿõһڶֵջ㣬ֽ
+class ImmediateEvaluator {
+private:
+    double _stack[EXPR_MAX_DEPTH];
+    int _top = -1;
+    std::string_view _text;
+
+    void require(int operands) {
+        if (_top + 1 < operands) throw std::invalid_argument("Missing operand in expression: " + std::string(_text));
+    }
+
+public:
+    explicit ImmediateEvaluator(std::string_view text) : _text(text) {}
+
+    void constant(double value) {
+        if (_top + 1 == EXPR_MAX_DEPTH) throw std::invalid_argument("Expression too deep: " + std::string(_text));
+        _stack[++_top] = value;
+    }
+
+    void variable(std::string_view) { throw std::invalid_argument("Unbound variable in expression: " + std::string(_text)); }
+
+    void apply(OpCode op) {
+        if (op <= OP_POW) {
+            require(2);
+            _top--;
+            _stack[_top] = applyOp(op, _stack[_top], _stack[_top + 1]);
+        } else {
+            require(1);
+            _stack[_top] = applyOp(op, _stack[_top], 0);
+        }
+    }
+
+    double result() const {
+        if (_top != 0) throw std::invalid_argument("Malformed expression: " + std::string(_text));
+        return _stack[0];
+    }
+};
+
+// ֵֻһεıʽļиıʽֵ߽ʡȥֽ룬Ҳռ䡣
+//  Expression(text).evaluate() ֱͬʽʱ׳ std::invalid_argument
+inline double evaluateOnce(std::string_view text) {
+    ImmediateEvaluator sink(text);
+    parseExpression(text, sink);
+    return sink.result();
+}
+
+// ɱʽıĻ棬ޣʱ̭δõһLRU
+//  optimize() ֮Ľı״γֵĴţ variable() ѯ
+//  string_view ңʱռ䣻ص shared_ptr ڸ̭ȻЧ̰߳ȫ
+class ExpressionCache {
+private:
+    typedef std::pair<std::string, std::shared_ptr<const Expression>> Entry;
+
+    size_t _capacity;
+    std::list<Entry> _entries;  // ʹõǰ
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> _index;  // ָ _entries еı
+    long long _hits, _misses;
+
+public:
+    explicit ExpressionCache(size_t capacity = 256) : _capacity(capacity), _hits(0), _misses(0) {}
+
+    ExpressionCache(ExpressionCache const&) = delete;
+    ExpressionCache& operator=(ExpressionCache const&) = delete;
+
+    // text ıڻʱ벢룻ʽʱ׳ std::invalid_argument治
+    std::shared_ptr<const Expression> get(std::string_view text) {
+        auto it = _index.find(text);
+        if (it != _index.end()) {
+            _hits++;
+            _entries.splice(_entries.begin(), _entries, it->second);
+            return it->second->second;
+        }
+        _misses++;
+        auto compiled = std::make_shared<Expression>(text);
+        compiled->optimize();
+        if (_capacity == 0) return compiled;
+        if (_entries.size() == _capacity) {
+            _index.erase(_entries.back().first);
+            _entries.pop_back();
+        }
+        _entries.emplace_front(std::string(text), compiled);
+        _index.emplace(_entries.front().first, _entries.begin());
+        return compiled;
+    }
+
+    size_t size() const { return _entries.size(); }
+    size_t capacity() const { return _capacity; }
+    long long hits() const { return _hits; }
+    long long misses() const { return _misses; }
+
+    void clear() {
+        _index.clear();
+        _entries.clear();
+    }
+};
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <charconv>            // Ϊʹ std::to_chars
+#include <condition_variable>  // Ϊʹ std::condition_variable
+#include <deque>               // Ϊʹ std::deque
+#include <istream>             // Ϊʹ std::istream
+#include <mutex>               // Ϊʹ std::mutex, std::unique_lock
+#include <ostream>             // Ϊʹ std::ostream
+#include <string>              // Ϊʹ std::string
+#include <string_view>         // Ϊʹ std::string_view
+#include <thread>              // Ϊʹ std::thread
+#include <vector>              // Ϊʹ std::vector
+
+#include "Expression.h"
+
+// ʽֵͳ
+struct StreamStats {
+    long long lines = 0;   // 
+    long long errors = 0;  // ޷ֵ
+};
+
+// һ룺мֵ
+struct StreamChunk {
+    std::string text;    // 룬Իнβļĩβһ⣩
+    std::string result;  // ÿһ
+    StreamStats stats;
+    bool done = false;   // Ƿֵ
+};
+
+// һ飺ȡһʣµİУٶ chunkBytes ֽڣһдضϣİһ顣
+// һг chunkBytes ʱֱлļĩβûиʱ false
+inline bool readChunk(std::istream& in, std::string& carry, std::string& text, size_t chunkBytes) {
+    text.swap(carry);
+    carry.clear();
+    for (;;) {
+        size_t old = text.size();
+        text.resize(old + chunkBytes);
+        in.read(&text[old], (std::streamsize)chunkBytes);
+        text.resize(old + (size_t)in.gcount());
+        if (!in) return !text.empty();  // ļĩβʣµȫ
+        size_t nl = std::string_view(text).substr(old).rfind('\n');  // ǰĲֲУֻ¶Ĳ
+        if (nl != std::string_view::npos) {
+            carry.assign(text, old + nl + 1, std::string::npos);
+            text.resize(old + nl + 1);
+            return true;
+        }
+    }
+}
+
+// ֵһ飺меĴʷԪ text ϵ string_view׷ӵ resultϴεĿռ䣩
+// У޷ֵ errorжӦ
+inline void evaluateChunk(StreamChunk& chunk) {
+    std::string_view text = chunk.text;
+    chunk.result.clear();
+    chunk.stats = StreamStats();
+    size_t i = 0;
+    while (i < text.size()) {
+        size_t j = text.find('\n', i);
+        if (j == std::string_view::npos) j = text.size();
+        std::string_view line = text.substr(i, j - i);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        i = j + 1;
+        chunk.stats.lines++;
+        if (line.find_first_not_of(" \t") != std::string_view::npos) {
+            try {
+                char buf[32];
+                auto r = std::to_chars(buf, buf + sizeof(buf), evaluateOnce(line));
+                chunk.result.append(buf, r.ptr);
+            } catch (std::invalid_argument const&) {
+                chunk.result += "error";
+                chunk.stats.errors++;
+            }
+        }
+        chunk.result += '\n';
+    }
+}
+
+// ʽֵin ÿһʽд out
+// ̰߳루ÿԼ chunkBytes ֽڣֻб߽紦з֣дthreads ̴߳Ӷȡֵ
+// ͬʱ;Ŀ鲻 2 * threads ڴռļС޹أĿռѭ
+inline StreamStats evaluateStream(std::istream& in, std::ostream& out, int threads, size_t chunkBytes = 1 << 20) {
+    if (threads < 1) threads = 1;
+    int window = 2 * threads;
+    std::vector<StreamChunk> slots(window);
+    std::deque<int> queue;  // ֵĿ飨slots ±꣩
+    bool finished = false;  // Ѷ
+    std::mutex m;
+    std::condition_variable workReady, chunkDone;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++)
+        workers.emplace_back([&] {
+            for (;;) {
+                int k;
+                {
+                    std::unique_lock<std::mutex> lock(m);
+                    workReady.wait(lock, [&] { return !queue.empty() || finished; });
+                    if (queue.empty()) return;
+                    k = queue.front();
+                    queue.pop_front();
+                }
+                evaluateChunk(slots[k]);
+                {
+                    std::lock_guard<std::mutex> lock(m);
+                    slots[k].done = true;
+                }
+                chunkDone.notify_one();
+            }
+        });
+
+    StreamStats total;
+    long long read = 0, written = 0;  // Ѷ롢дĿ
+    // дһ飻wait Ϊ false ʱÿδֵͷ false
+    auto writeNext = [&](bool wait) {
+        StreamChunk& c = slots[written % window];
+        {
+            std::unique_lock<std::mutex> lock(m);
+            if (wait) chunkDone.wait(lock, [&] { return c.done; });
+            else if (!c.done) return false;
+        }
+        out.write(c.result.data(), (std::streamsize)c.result.size());
+        total.lines += c.stats.lines;
+        total.errors += c.stats.errors;
+        written++;
+        return true;
+    };
+
+    std::string carry;
+    for (;;) {
+        if (read - written == window) writeNext(true);  // ;Ŀһдٶ
+        StreamChunk& c = slots[read % window];
+        if (!readChunk(in, carry, c.text, chunkBytes)) break;
+        {
+            std::lock_guard<std::mutex> lock(m);
+            c.done = false;
+            queue.push_back((int)(read % window));
+        }
+        workReady.notify_one();
+        read++;
+        while (written < read && writeNext(false)) {}
+    }
+    {
+        std::lock_guard<std::mutex> lock(m);
+        finished = true;
+    }
+    workReady.notify_all();
+    while (written < read) writeNext(true);
+    for (std::thread& w : workers) w.join();
+    return total;
+}
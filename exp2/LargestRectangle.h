@@ -0,0 +1,366 @@
+#pragma once
+
+#include <algorithm>  // Ϊʹ std::max, std::min, std::lower_bound, std::copy, std::copy_backward, std::fill
+#include <cstdint>    // Ϊʹ std::uint64_t
+#include <fstream>    // Ϊʹ std::ifstream
+#include <stdexcept>  // Ϊʹ std::runtime_error
+#include <string>     // Ϊʹ std::string
+#include <thread>     // Ϊʹ std::thread
+#include <vector>     // Ϊʹ std::vector
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define RECT_HAS_AVX2 1
+#endif
+
+// ջɨ裻Locate Ϊʱεȣͬʱȡһ
+// ջ˳ֻʱ滻ҵһ
+template <bool Locate>
+inline long long largestAreaScan(int const* heights, int n, int* stack, int* left, int* width) {
+    long long maxArea = 0;
+    int top = -1;  // ջλãջ±Ӧĸ߶Եϵ
+    for (int i = 0; i <= n; i++) {
+        int h = (i == n) ? 0 : heights[i];
+        while (top >= 0 && h < heights[stack[top]]) {
+            long long height = heights[stack[top--]];
+            long long w = top < 0 ? i : i - stack[top] - 1;
+            long long area = height * w;
+            if (area > maxArea || (Locate && area == maxArea && area > 0 && i - (int)w < *left)) {
+                maxArea = area;
+                if (Locate) *left = i - (int)w, *width = (int)w;
+            }
+        }
+        stack[++top] = i;
+    }
+    return maxArea;
+}
+
+// ջģֱͼ heights[0, n) ε߶ȾǸ
+// ջɵṩ n + 1 ±꣬ռ䣻 64 λ㣬
+inline long long largestAreaKernel(int const* heights, int n, int* stack) {
+    return largestAreaScan<false>(heights, n, stack, nullptr, nullptr);
+}
+
+// Ĺ߳threads <= 0 ʱȡӲ߳ܳȽСʱֵ߳
+inline int largestAreaThreads(int threads, long long total) {
+    if (threads <= 0) threads = std::max(1, (int)std::thread::hardware_concurrency());
+    const long long MIN_WORK = 1 << 16;  // ÿ߳ٷֵ
+    return (int)std::max(1LL, std::min((long long)threads, total / MIN_WORK));
+}
+
+// 㣺 i ֱͼΪ heights[offsets[i], offsets[i + 1])д areas[i]i = 0, 1, ..., count - 1
+// ֱͼΪ threads 䣬һ̼߳㣻ÿֻ߳һջ
+// СΪֱͼ˺ֱͼ
+inline void largestAreas(int const* heights, long long const* offsets, int count, long long* areas, int threads = 0) {
+    if (count <= 0) return;
+    auto work = [=](int lo, int hi) {
+        long long longest = 0;
+        for (int i = lo; i < hi; i++) longest = std::max(longest, offsets[i + 1] - offsets[i]);
+        std::vector<int> stack((size_t)longest + 1);
+        for (int i = lo; i < hi; i++)
+            areas[i] = largestAreaKernel(heights + offsets[i], (int)(offsets[i + 1] - offsets[i]), stack.data());
+    };
+    long long total = offsets[count] - offsets[0];
+    threads = largestAreaThreads(threads, total);
+    if (threads == 1) return work(0, count);
+
+    //  t δ׸㲻С offsets[0] + total * t / threads ֱͼʼ
+    std::vector<int> bounds(threads + 1);
+    bounds[0] = 0;
+    bounds[threads] = count;
+    for (int t = 1; t < threads; t++)
+        bounds[t] = (int)(std::lower_bound(offsets, offsets + count, offsets[0] + total * t / threads) - offsets);
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; t++) workers.emplace_back(work, bounds[t], bounds[t + 1]);
+    work(bounds[0], bounds[1]);
+    for (std::thread& w : workers) w.join();
+}
+
+inline std::vector<long long> largestAreas(std::vector<int> const& heights, std::vector<long long> const& offsets,
+                                           int threads = 0) {
+    std::vector<long long> areas(offsets.empty() ? 0 : offsets.size() - 1);
+    largestAreas(heights.data(), offsets.data(), (int)areas.size(), areas.data(), threads);
+    return areas;
+}
+
+// λѹ 0/1 ÿռ words()  64 λ֣ c ڵ c / 64 ֵĵ c % 64 λĩλΪ 0
+class BitMatrix {
+private:
+    int _rows, _cols, _words;
+    std::vector<std::uint64_t> _bits;
+
+public:
+    BitMatrix(int rows = 0, int cols = 0) : _rows(rows), _cols(cols), _words((cols + 63) / 64), _bits((size_t)rows * _words) {}
+
+    // ıļ룺ÿһУַ '1' Ϊ 1ַΪ 0ȡһУ϶̵Ҳಹ 0
+    // ÿһмΪ֣ıδ֪ݰ stride ִţʱ stride ټӱ
+    // ѶУԭѹΪյÿֵڴԼΪ 2 
+    static BitMatrix load(std::string const& path) {
+        std::ifstream in(path);
+        if (!in) throw std::runtime_error("BitMatrix: cannot open " + path);
+        std::vector<std::uint64_t> bits;
+        size_t rows = 0, cols = 0, stride = 1;
+        std::string line;
+        while (std::getline(in, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            size_t need = (line.size() + 63) / 64;
+            if (need > stride) {  // ԺǰѸƵµλãλòھλ
+                size_t wider = std::max(need, 2 * stride);
+                bits.resize(rows * wider, 0);
+                for (size_t r = rows; r-- > 0;) {
+                    std::copy_backward(bits.begin() + r * stride, bits.begin() + (r + 1) * stride, bits.begin() + r * wider + stride);
+                    std::fill(bits.begin() + r * wider + stride, bits.begin() + (r + 1) * wider, 0);
+                }
+                stride = wider;
+            }
+            bits.resize((rows + 1) * stride, 0);
+            std::uint64_t* w = bits.data() + rows * stride;
+            for (size_t c = 0; c < line.size(); c++)
+                if (line[c] == '1') w[c / 64] |= (std::uint64_t)1 << (c % 64);
+            cols = std::max(cols, line.size());
+            rows++;
+        }
+        BitMatrix m;
+        m._rows = (int)rows;
+        m._cols = (int)cols;
+        m._words = (int)((cols + 63) / 64);
+        for (size_t r = 0; r < rows; r++)  // ѹλòھλãǰƶ
+            std::copy(bits.begin() + r * stride, bits.begin() + r * stride + m._words, bits.begin() + r * m._words);
+        bits.resize(rows * m._words);
+        m._bits = std::move(bits);
+        return m;
+    }
+
+    int rows() const { return _rows; }
+    int cols() const { return _cols; }
+    int words() const { return _words; }
+
+    bool test(int r, int c) const { return _bits[(size_t)r * _words + c / 64] >> (c % 64) & 1; }
+    void set(int r, int c, bool v = true) {
+        std::uint64_t& w = _bits[(size_t)r * _words + c / 64];
+        w = v ? w | (std::uint64_t)1 << (c % 64) : w & ~((std::uint64_t)1 << (c % 64));
+    }
+
+    //  r еĸ
+    std::uint64_t const* row(int r) const { return _bits.data() + (size_t)r * _words; }
+    std::uint64_t* row(int r) { return _bits.data() + (size_t)r * _words; }
+};
+
+// ȫ 1 ӾϽ (top, left) height  width 
+struct MaximalRectangle {
+    long long area = 0;
+    int top = 0, left = 0, height = 0, width = 0;
+};
+
+// и¸и߶ȣн 1 ĸΪ 1 мһΪ 0 㡣
+// ͨð汾д޷֧ʽ
+inline void updateHeightsScalar(std::uint64_t const* bits, int lo, int cols, int* heights) {
+    for (int c = lo; c < cols; c++) heights[c] = (heights[c] + 1) & -(int)(bits[c / 64] >> (c % 64) & 1);
+}
+
+#ifdef RECT_HAS_AVX2
+// AVX2 汾ÿȡ 8 λչΪ 8  32 λ룬8 һһ
+__attribute__((target("avx2"))) inline void updateHeightsAvx2(std::uint64_t const* bits, int cols, int* heights) {
+    const __m256i lanes = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128), one = _mm256_set1_epi32(1);
+    int c = 0;
+    for (; c + 8 <= cols; c += 8) {
+        int byte = (int)(bits[c / 64] >> (c % 64) & 0xFF);
+        __m256i mask = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(byte), lanes), lanes);
+        __m256i h = _mm256_loadu_si256((__m256i const*)(heights + c));
+        _mm256_storeu_si256((__m256i*)(heights + c), _mm256_and_si256(_mm256_add_epi32(h, one), mask));
+    }
+    updateHeightsScalar(bits, c, cols, heights);
+}
+#endif
+
+inline void updateHeights(std::uint64_t const* bits, int cols, int* heights) {
+#ifdef RECT_HAS_AVX2
+    static const bool avx2 = (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+    if (avx2) return updateHeightsAvx2(bits, cols, heights);
+#endif
+    updateHeightsScalar(bits, 0, cols, heights);
+}
+
+// ȫ 1 Ӿ϶и¸и߶ȣÿԸ߶Ϊֱͼõջġ
+// ʱѸоΪ threads ˣ
+//   1. ȫ 0 ĸ߶ֻ߶ȸ£õ׸ 1 ĸ
+//   2. ϶κϲʼĸ߶ȣһΪ 1 ʱϷĸ߶ӣɨһ顣
+// ȡľΣͬʱȡױϡһthreads <= 0 ʱȡӲ߳
+inline MaximalRectangle maximalRectangle(BitMatrix const& m, int threads = 0) {
+    int rows = m.rows(), cols = m.cols();
+    MaximalRectangle best;
+    if (rows == 0 || cols == 0) return best;
+    threads = std::min(largestAreaThreads(threads, (long long)rows * cols), rows);
+
+    std::vector<int> bounds(threads + 1);  //  t Ϊ [bounds[t], bounds[t + 1]) 
+    for (int t = 0; t <= threads; t++) bounds[t] = (int)((long long)rows * t / threads);
+    std::vector<std::vector<int>> heights(threads, std::vector<int>(cols, 0));
+
+    auto runParallel = [&](auto const& body) {
+        std::vector<std::thread> workers;
+        for (int t = 1; t < threads; t++) workers.emplace_back(body, t);
+        body(0);
+        for (std::thread& w : workers) w.join();
+    };
+
+    if (threads > 1) {
+        std::vector<std::vector<int>> bottom(threads, std::vector<int>(cols, 0));  // ײ 1 ĸ
+        runParallel([&](int t) {
+            for (int r = bounds[t]; r < bounds[t + 1]; r++) updateHeights(m.row(r), cols, bottom[t].data());
+        });
+        for (int t = 1; t < threads; t++) {
+            int strip = bounds[t] - bounds[t - 1];
+            for (int c = 0; c < cols; c++)
+                heights[t][c] = bottom[t - 1][c] + (bottom[t - 1][c] == strip ? heights[t - 1][c] : 0);
+        }
+    }
+
+    std::vector<MaximalRectangle> found(threads);
+    runParallel([&](int t) {
+        std::vector<int>& h = heights[t];
+        std::vector<int> stack(cols + 1);
+        MaximalRectangle& f = found[t];
+        for (int r = bounds[t]; r < bounds[t + 1]; r++) {
+            updateHeights(m.row(r), cols, h.data());
+            int left = 0, width = 0;
+            long long area = largestAreaScan<true>(h.data(), cols, stack.data(), &left, &width);
+            if (area > f.area) {
+                f.area = area;
+                f.left = left;
+                f.width = width;
+                f.height = (int)(area / width);
+                f.top = r - f.height + 1;
+            }
+        }
+    });
+    for (MaximalRectangle const& f : found)
+        if (f.area > best.area) best = f;
+    return best;
+}
+
+// ʽΣ߶ɿ飩ʱѵﲿε
+// ñջջи߶ϸͬĸ߶ֻһÿ̯ O(1) ջջ
+// ѳջľֻջδľ k ڹ x ʱΪ h_k * (x - s_k)
+// ǹ x ֱߣбջԵϵάЩֱߵ͹ջʱֶλ±ǵһ
+// ջʱȳĴָmax() ͹϶ֲѯΪ O(log S)S Ϊջ
+// ջͬ߶ȵĸ߶ȵȡֵΧʱڴռĳ޹ء
+// window > 0 ʱֻ window 뻷λmax() ԴڵõջģΪ O(window)
+class LargestRectangleStream {
+private:
+    struct Bar {
+        long long start;  // ε
+        int height;
+        int hullPos;      // ͹λ
+        int hullSaved;    // λԭеһûʱΪ -1
+        int hullSize;     // ͹ǰ͹ĴС
+    };
+
+    long long _count;          // ѵ
+    long long _closed;         // ѳջľε
+    std::vector<Bar> _bars;    // ջ
+    std::vector<int> _hull;    // ͹ջе±
+    int _hullSize;
+    int _window;               // ڴС0 ʾ
+    std::vector<int> _ring;    // ڵ
+    mutable std::vector<int> _scratch;  // ѯʱչ뵥ջ
+
+    // ջе k ֱ x ֵ
+    long long area(int k, long long x) const { return (long long)_bars[k].height * (x - _bars[k].start); }
+
+    // бֱ k ͹еֱ jǰһΪ iǷҪ
+    bool covered(int i, int j, int k) const {
+        __int128 a1 = _bars[i].height, a2 = _bars[j].height, a3 = _bars[k].height;
+        __int128 b1 = -a1 * _bars[i].start, b2 = -a2 * _bars[j].start, b3 = -a3 * _bars[k].start;
+        return (b3 - b1) * (a2 - a1) >= (b2 - b1) * (a3 - a1);
+    }
+
+    void pushBar(long long start, int height) {
+        int k = (int)_bars.size();
+        _bars.push_back(Bar{start, height, 0, -1, _hullSize});
+        int lo = 1, hi = _hullSize;  // ׸Ҫλãһ͹
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (covered(_hull[mid - 1], _hull[mid], k)) hi = mid;
+            else lo = mid + 1;
+        }
+        int p = _hullSize == 0 ? 0 : lo;
+        Bar& b = _bars[k];
+        b.hullPos = p;
+        if (p < (int)_hull.size()) {
+            b.hullSaved = _hull[p];
+            _hull[p] = k;
+        } else {
+            _hull.push_back(k);
+        }
+        _hullSize = p + 1;
+    }
+
+    void popBar() {
+        Bar const& b = _bars.back();
+        if (b.hullSaved >= 0) _hull[b.hullPos] = b.hullSaved;
+        _hullSize = b.hullSize;
+        _bars.pop_back();
+    }
+
+public:
+    explicit LargestRectangleStream(int window = 0) : _count(0), _closed(0), _hullSize(0), _window(window > 0 ? window : 0) {
+        _ring.reserve(_window);
+    }
+
+    // һ߶ȷǸ
+    void push(int h) {
+        if (_window > 0) {
+            if ((int)_ring.size() < _window) _ring.push_back(h);
+            else _ring[_count % _window] = h;
+            _count++;
+            return;
+        }
+        long long start = _count;
+        while (!_bars.empty() && _bars.back().height > h) {
+            Bar const& b = _bars.back();
+            _closed = std::max(_closed, (long long)b.height * (_count - b.start));
+            start = b.start;
+            popBar();
+        }
+        if (h > 0 && (_bars.empty() || _bars.back().height < h)) pushBar(start, h);
+        _count++;
+    }
+
+    // ɿ鵽 heights[0, n)
+    void push(int const* heights, int n) {
+        for (int i = 0; i < n; i++) push(heights[i]);
+    }
+
+    // ѵﲿ֣ window ε
+    long long max() const {
+        if (_window > 0) {
+            int n = (int)_ring.size();
+            _scratch.resize(2 * (size_t)n + 1);
+            int first = n < _window ? 0 : (int)(_count % _window);  // 
+            for (int i = 0; i < n; i++) _scratch[i] = _ring[(first + i) % n];
+            return largestAreaKernel(_scratch.data(), n, _scratch.data() + n);
+        }
+        if (_hullSize == 0) return _closed;
+        int lo = 0, hi = _hullSize - 1;  //  x = _count ͹ϸֱߵֵ
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (area(_hull[mid], _count) < area(_hull[mid + 1], _count)) lo = mid + 1;
+            else hi = mid;
+        }
+        return std::max(_closed, area(_hull[lo], _count));
+    }
+
+    long long count() const { return _count; }
+    int window() const { return _window; }
+
+    // ջȣģʽΪ 0
+    int depth() const { return (int)_bars.size(); }
+
+    void clear() {
+        _count = _closed = 0;
+        _bars.clear();
+        _hull.clear();
+        _hullSize = 0;
+        _ring.clear();
+    }
+};
@@ -0,0 +1,354 @@
+#pragma once
+
+#include <algorithm>  // Ϊʹ std::min, std::copy
+#include <climits>    // Ϊʹ INT_MAX
+#include <cstdint>    // Ϊʹ std::uint64_t
+#include <iostream>   // Ϊʹ std::cout
+#include <string>     // Ϊʹ std::string
+#include <vector>     // Ϊʹ std::vector
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define BITMAP_X86 1
+#endif
+
+//  n  1 ĸ
+inline long long popcountWordsScalar(std::uint64_t const* w, size_t n) {
+    long long c = 0;
+    for (size_t i = 0; i < n; i++) c += __builtin_popcountll(w[i]);
+    return c;
+}
+
+#ifdef BITMAP_X86
+// ʹ popcnt ָİ汾
+__attribute__((target("popcnt"))) inline long long popcountWordsHw(std::uint64_t const* w, size_t n) {
+    long long c = 0;
+    for (size_t i = 0; i < n; i++) c += __builtin_popcountll(w[i]);
+    return c;
+}
+
+inline bool cpuHasPopcnt() {
+    static const bool has = (__builtin_cpu_init(), __builtin_cpu_supports("popcnt"));
+    return has;
+}
+#endif
+
+inline long long popcountWords(std::uint64_t const* w, size_t n) {
+#ifdef BITMAP_X86
+    if (cpuHasPopcnt()) return popcountWordsHw(w, n);
+#endif
+    return popcountWordsScalar(w, n);
+}
+
+//  1 ĸSWAR д popcnt ָҲп
+inline int popcount64(std::uint64_t w) {
+    w = w - ((w >> 1) & 0x5555555555555555ULL);
+    w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+    w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((w * 0x0101010101010101ULL) >> 56);
+}
+
+//  w е r  0 Ϊ 1 λλãw  r + 1  1
+// Ȱ SWAR ֽ 1 ĸǰ׺ͣλڵֽڣֽ͵ 1
+inline int selectInWord(std::uint64_t w, int r) {
+    std::uint64_t s = w - ((w >> 1) & 0x5555555555555555ULL);
+    s = (s & 0x3333333333333333ULL) + ((s >> 2) & 0x3333333333333333ULL);
+    s = ((s + (s >> 4)) & 0x0F0F0F0F0F0F0F0FULL) * 0x0101010101010101ULL;  //  i ֽڣǰ i + 1 ֽ 1 ĸ
+    int byte = 0;
+    while ((int)(s >> (8 * byte) & 0xFF) <= r) byte++;
+    if (byte > 0) r -= (int)(s >> (8 * (byte - 1)) & 0xFF);
+    unsigned b = (unsigned)(w >> (8 * byte) & 0xFF);
+    for (; r > 0; r--) b &= b - 1;
+    return 8 * byte + __builtin_ctz(b);
+}
+
+// λͼ֮λ
+enum BitOp { BIT_AND, BIT_OR, BIT_XOR, BIT_ANDNOT };
+
+template <BitOp op>
+inline std::uint64_t bitOp(std::uint64_t a, std::uint64_t b) {
+    return op == BIT_AND ? a & b : op == BIT_OR ? a | b : op == BIT_XOR ? a ^ b : a & ~b;
+}
+
+// ͨð汾dst[i] = a[i] op b[i]i = 0, 1, ..., n - 1dst  a  b ͬ
+template <BitOp op>
+inline void combineWordsScalar(std::uint64_t* dst, std::uint64_t const* a, std::uint64_t const* b, size_t n) {
+    for (size_t i = 0; i < n; i++) dst[i] = bitOp<op>(a[i], b[i]);
+}
+
+// ͨð汾a[i] op b[i]  1 ĸ֮ͣд
+template <BitOp op>
+inline long long combineCountScalar(std::uint64_t const* a, std::uint64_t const* b, size_t n) {
+    long long c = 0;
+    for (size_t i = 0; i < n; i++) c += popcount64(bitOp<op>(a[i], b[i]));
+    return c;
+}
+
+#ifdef BITMAP_X86
+inline bool bitmapHasAvx2() {
+    static const bool has = (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+    return has;
+}
+
+template <BitOp op>
+__attribute__((target("avx2"))) inline __m256i bitOpAvx2(__m256i a, __m256i b) {
+    return op == BIT_AND ? _mm256_and_si256(a, b)
+         : op == BIT_OR ? _mm256_or_si256(a, b)
+         : op == BIT_XOR ? _mm256_xor_si256(a, b)
+         : _mm256_andnot_si256(b, a);
+}
+
+// AVX2 汾ÿδ 4 ֣ѭչһβͨð汾
+template <BitOp op>
+__attribute__((target("avx2"))) inline void combineWordsAvx2(std::uint64_t* dst, std::uint64_t const* a,
+                                                               std::uint64_t const* b, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x0 = _mm256_loadu_si256((__m256i const*)(a + i)), y0 = _mm256_loadu_si256((__m256i const*)(b + i));
+        __m256i x1 = _mm256_loadu_si256((__m256i const*)(a + i + 4)), y1 = _mm256_loadu_si256((__m256i const*)(b + i + 4));
+        _mm256_storeu_si256((__m256i*)(dst + i), bitOpAvx2<op>(x0, y0));
+        _mm256_storeu_si256((__m256i*)(dst + i + 4), bitOpAvx2<op>(x1, y1));
+    }
+    combineWordsScalar<op>(dst + i, a + i, b + i, n - i);
+}
+
+// 256 λ 1 ĸ 4  64 λֱֽڲvpshufbֽͣvpsadbw
+__attribute__((target("avx2"))) inline __m256i popcount256(__m256i v) {
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0F);
+    __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low));
+    __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+    return _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256());
+}
+
+template <BitOp op>
+__attribute__((target("avx2"))) inline long long combineCountAvx2(std::uint64_t const* a, std::uint64_t const* b, size_t n) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i x = _mm256_loadu_si256((__m256i const*)(a + i)), y = _mm256_loadu_si256((__m256i const*)(b + i));
+        acc = _mm256_add_epi64(acc, popcount256(bitOpAvx2<op>(x, y)));
+    }
+    long long c = _mm256_extract_epi64(acc, 0) + _mm256_extract_epi64(acc, 1) + _mm256_extract_epi64(acc, 2)
+                + _mm256_extract_epi64(acc, 3);
+    return c + combineCountScalar<op>(a + i, b + i, n - i);
+}
+#endif
+
+template <BitOp op>
+inline void combineWords(std::uint64_t* dst, std::uint64_t const* a, std::uint64_t const* b, size_t n) {
+#ifdef BITMAP_X86
+    if (bitmapHasAvx2()) return combineWordsAvx2<op>(dst, a, b, n);
+#endif
+    combineWordsScalar<op>(dst, a, b, n);
+}
+
+template <BitOp op>
+inline long long combineCount(std::uint64_t const* a, std::uint64_t const* b, size_t n) {
+#ifdef BITMAP_X86
+    if (bitmapHasAvx2()) return combineCountAvx2<op>(a, b, n);
+#endif
+    return combineCountScalar<op>(a, b, n);
+}
+
+// λͼ 64 λִţ k λڵ k / 64 ֵĵ k % 64 λ
+// count() ּrank()select() 轨Ŀ¼ÿ 512 λ8 ֣Ϊһ飬´ǰ 1 ĸ
+// ÿ SELECT_SAMPLE  1 ڵĳ顣Ŀ¼޸ĺ״βѯʱؽO(n / 64)˺ rank Ϊ O(1)
+// select ֻ֮ĳвҡ
+// λͼ֮롢򡢲㼰 and_count()or_count() ֽУCPU ֧ʱʹ AVX2
+class Bitmap {
+public:
+    static constexpr int BLOCK_WORDS = 8;       // ÿ
+    static constexpr int SELECT_SAMPLE = 4096;  // select Ĳ1 ĸ
+
+private:
+    std::vector<std::uint64_t> M;
+    int N, _sz;
+
+    mutable bool _indexed = false;              // Ŀ¼Ƿһ
+    mutable std::vector<long long> _rank;       // _rank[b] b ֮ǰ 1 ĸĩΪ
+    mutable std::vector<int> _selectSample;     // _selectSample[i] i * SELECT_SAMPLE  1 ڵĳ
+
+    void buildIndex() const {
+        int words = (int)M.size(), blocks = (words + BLOCK_WORDS - 1) / BLOCK_WORDS;
+        _rank.assign(blocks + 1, 0);
+        _selectSample.clear();
+        long long ones = 0;
+        for (int b = 0; b < blocks; b++) {
+            _rank[b] = ones;
+            int lo = b * BLOCK_WORDS, n = std::min(BLOCK_WORDS, words - lo);
+            long long c = popcountWords(M.data() + lo, n);
+            // ڵĵ ones..ones + c - 1  1 УǲĶڱ
+            while ((long long)_selectSample.size() * SELECT_SAMPLE < ones + c) _selectSample.push_back(b);
+            ones += c;
+        }
+        _rank[blocks] = ones;
+        _indexed = true;
+    }
+
+protected:
+    void init(int n) {
+        N = n;
+        M.assign(((size_t)N + 63) / 64, 0);  // ÿ64bitһ֣ʼΪ0
+        _sz = n;
+        _indexed = false;
+    }
+
+public:
+    Bitmap(int n = 8) {
+        init(n);
+    } // ʼλͼС
+
+    void set(int k) { // õ k λΪ 1
+        if (k >= N) {
+            expand(k);
+        }
+        M[k >> 6] |= (std::uint64_t)1 << (k & 63);
+        _indexed = false;
+    }
+
+    void clear(int k) { //  k λΪ 0
+        if (k >= N) {
+            expand(k);
+        }
+        M[k >> 6] &= ~((std::uint64_t)1 << (k & 63));
+        _indexed = false;
+    }
+
+    bool test(int k) const { // Ե k λǷΪ 1ΧλΪ 0
+        if (k < 0 || k >= N) return false;
+        return M[k >> 6] >> (k & 63) & 1;
+    }
+
+    int size() const { return _sz; }
+
+    // 1 ĸ
+    long long count() const { return popcountWords(M.data(), M.size()); }
+
+    // [0, k)  1 ĸ
+    long long rank(int k) const {
+        if (k <= 0) return 0;
+        if (k >= N) return count();
+        if (!_indexed) buildIndex();
+        int w = k >> 6, b = w / BLOCK_WORDS;
+        long long r = _rank[b] + popcountWords(M.data() + b * BLOCK_WORDS, w - b * BLOCK_WORDS);
+        if (k & 63) r += popcount64(M[w] & (((std::uint64_t)1 << (k & 63)) - 1));
+        return r;
+    }
+
+    //  j  0 Ϊ 1 λλãj С 1 ĸʱ -1
+    int select(long long j) const {
+        if (j < 0) return -1;
+        if (!_indexed) buildIndex();
+        int blocks = (int)_rank.size() - 1;
+        if (j >= _rank[blocks]) return -1;
+        //  j  1 ڵĳ֮䣬ж
+        size_t s = (size_t)(j / SELECT_SAMPLE);
+        int lo = _selectSample[s], hi = s + 1 < _selectSample.size() ? _selectSample[s + 1] : blocks - 1;
+        while (lo < hi) {  // һ _rank[b] <= j ĳ
+            int mid = (lo + hi + 1) / 2;
+            if (_rank[mid] <= j) lo = mid;
+            else hi = mid - 1;
+        }
+        long long r = j - _rank[lo];
+        for (int w = lo * BLOCK_WORDS;; w++) {
+            int c = popcount64(M[w]);
+            if (r < c) return w * 64 + selectInWord(M[w], (int)r);
+            r -= c;
+        }
+    }
+
+    // ηÿΪ 1 λȡ͵ 1ctzȫ 0 һ
+    template <typename VST>
+    void traverse(VST& visit) const {
+        for (size_t w = 0; w < M.size(); w++)
+            for (std::uint64_t bits = M[w]; bits; bits &= bits - 1) visit((int)(w * 64 + __builtin_ctzll(bits)));
+    }
+
+    // Ե k λһΪ 1 λûʱ -1
+    int next(int k) const {
+        if (k < 0) k = 0;
+        if (k >= N) return -1;
+        size_t w = k >> 6;
+        std::uint64_t bits = M[w] & (~(std::uint64_t)0 << (k & 63));
+        while (!bits) {
+            if (++w == M.size()) return -1;
+            bits = M[w];
+        }
+        return (int)(w * 64 + __builtin_ctzll(bits));
+    }
+
+    // ִŵݣ words() 
+    std::uint64_t const* data() const { return M.data(); }
+    int words() const { return (int)M.size(); }
+
+    std::string toString() const { // ǰ size() λĶƴ
+        std::string s(_sz, '0');
+        for (int k = next(0); k >= 0 && k < _sz; k = next(k + 1)) s[k] = '1';
+        return s;
+    }
+
+    void dump() const { // λͼĶƴ
+        std::cout << toString() << std::endl;
+    }
+
+    void expand(int k) { // չλͼС
+        if (k < N) return;  // kСڵǰСҪչ
+        std::vector<std::uint64_t> old;
+        old.swap(M);
+        // չԭС 2  k + 1 λʱչ k + 1 λֻ 2 * k չʱ
+        // һܴ±ͻռ 2 
+        init((int)std::min<long long>(std::max<long long>(k + 1LL, 2LL * N), INT_MAX));
+        std::copy(old.begin(), old.end(), M.begin());  // ƾ
+    }
+
+    //  B λ㣬ߴСͬʱ϶ȱٵλ 0 ƣ
+    // Ͳ㣨ANDNOTĽķΧĽչнϴķΧ
+    template <BitOp op>
+    Bitmap& combine(Bitmap const& B) {
+        if ((op == BIT_OR || op == BIT_XOR) && B.N > N) {
+            M.resize(B.M.size(), 0);
+            N = B.N;
+            _sz = std::max(_sz, B._sz);
+        }
+        size_t common = std::min(M.size(), B.M.size());
+        combineWords<op>(M.data(), M.data(), B.M.data(), common);
+        if (op == BIT_AND) std::fill(M.begin() + common, M.end(), 0);
+        _indexed = false;
+        return *this;
+    }
+
+    Bitmap& operator&=(Bitmap const& B) { return combine<BIT_AND>(B); }
+    Bitmap& operator|=(Bitmap const& B) { return combine<BIT_OR>(B); }
+    Bitmap& operator^=(Bitmap const& B) { return combine<BIT_XOR>(B); }
+    Bitmap& andNot(Bitmap const& B) { return combine<BIT_ANDNOT>(B); }  //  B Ϊ 1 λ
+
+    // A op B ΪµλͼһдСȡнϴ
+    template <BitOp op>
+    static Bitmap combined(Bitmap const& A, Bitmap const& B) {
+        Bitmap R(std::max(A.N, B.N));
+        R._sz = std::max(A._sz, B._sz);
+        size_t common = std::min(A.M.size(), B.M.size());
+        combineWords<op>(R.M.data(), A.M.data(), B.M.data(), common);
+        if (op != BIT_AND) {  // ϳߵʣಿ֣ 0 򲻱䣻ֻ A ʣಿ
+            Bitmap const& longer = A.M.size() >= B.M.size() ? A : B;
+            if (op != BIT_ANDNOT || &longer == &A) std::copy(longer.M.begin() + common, longer.M.end(), R.M.begin() + common);
+        }
+        return R;
+    }
+
+    // A  B λ롢֮ 1 ĸɽ
+    long long and_count(Bitmap const& B) const { return combineCount<BIT_AND>(M.data(), B.M.data(), std::min(M.size(), B.M.size())); }
+    long long or_count(Bitmap const& B) const {
+        size_t common = std::min(M.size(), B.M.size());
+        Bitmap const& longer = M.size() >= B.M.size() ? *this : B;
+        return combineCount<BIT_OR>(M.data(), B.M.data(), common)
+             + popcountWords(longer.M.data() + common, longer.M.size() - common);
+    }
+};
+
+inline Bitmap operator&(Bitmap const& A, Bitmap const& B) { return Bitmap::combined<BIT_AND>(A, B); }
+inline Bitmap operator|(Bitmap const& A, Bitmap const& B) { return Bitmap::combined<BIT_OR>(A, B); }
+inline Bitmap operator^(Bitmap const& A, Bitmap const& B) { return Bitmap::combined<BIT_XOR>(A, B); }
+inline Bitmap andNot(Bitmap const& A, Bitmap const& B) { return Bitmap::combined<BIT_ANDNOT>(A, B); }
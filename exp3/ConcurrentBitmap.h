@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>   // Ϊʹ std::atomic, std::memory_order
+#include <cstddef>  // Ϊʹ size_t
+#include <cstdint>  // Ϊʹ std::uint64_t
+#include <memory>   // Ϊʹ std::unique_ptr
+
+#include "Bitmap.h"
+
+// ɹ߳ͬʱдλͼ粢бе visited ϡ
+// ڹʱȷչBitmap::set() ܾ expand() ·䣬߳еĵַ֮ʧЧ
+// ÿ 64 λһ std::atomicλΪֵԭ fetch_or / fetch_andᶪʧ̵߳޸ġ
+// test_and_set() ȶһμ飬Ϊ 1 ʱдⷴͬһУζ acquire ˳
+// Ҫ relaxed ʱ relaxedѱǵ߳ͬܿڱ֮ǰдݡ
+// count()traverse() ȡ relaxed ˳ֶֻӦڸ߳д꣨ join ֮ʹã
+// ֽĳ
+class ConcurrentBitmap {
+    std::unique_ptr<std::atomic<std::uint64_t>[]> M;
+    size_t N, _words;
+
+public:
+    explicit ConcurrentBitmap(size_t n) : M(new std::atomic<std::uint64_t>[(n + 63) / 64]), N(n), _words((n + 63) / 64) {
+        reset();
+    }
+
+    size_t size() const { return N; }
+    size_t words() const { return _words; }
+
+    bool test(size_t k, std::memory_order order = std::memory_order_acquire) const { // Ե k λǷΪ 1
+        return M[k >> 6].load(order) >> (k & 63) & 1;
+    }
+
+    //  k λΪ 1ԭֵ false ̼߳ǵһǸλ߳
+    bool test_and_set(size_t k, std::memory_order order = std::memory_order_acq_rel) {
+        std::uint64_t bit = (std::uint64_t)1 << (k & 63);
+        std::memory_order check = order == std::memory_order_relaxed ? std::memory_order_relaxed : std::memory_order_acquire;
+        if (M[k >> 6].load(check) & bit) return true;
+        return M[k >> 6].fetch_or(bit, order) & bit;
+    }
+
+    //  k λΪ 0ԭֵ
+    bool test_and_clear(size_t k, std::memory_order order = std::memory_order_acq_rel) {
+        std::uint64_t bit = (std::uint64_t)1 << (k & 63);
+        return M[k >> 6].fetch_and(~bit, order) & bit;
+    }
+
+    void set(size_t k) { test_and_set(k); }
+    void clear(size_t k) { test_and_clear(k); }
+
+    //  w  mask λ򣬷ԭֵһαͬһеĶλ
+    std::uint64_t fetch_or(size_t w, std::uint64_t mask, std::memory_order order = std::memory_order_acq_rel) {
+        return M[w].fetch_or(mask, order);
+    }
+
+    std::uint64_t word(size_t w, std::memory_order order = std::memory_order_relaxed) const {
+        return M[w].load(order);
+    }
+
+    // 1 ĸ
+    long long count() const {
+        long long c = 0;
+        for (size_t w = 0; w < _words; w++) c += popcount64(M[w].load(std::memory_order_relaxed));
+        return c;
+    }
+
+    // ηÿΪ 1 λ
+    template <typename VST>
+    void traverse(VST& visit) const {
+        for (size_t w = 0; w < _words; w++)
+            for (std::uint64_t bits = M[w].load(std::memory_order_relaxed); bits; bits &= bits - 1)
+                visit(w * 64 + __builtin_ctzll(bits));
+    }
+
+    // ȫΪ 0̵߳Ķдͬʱ
+    void reset() {
+        for (size_t w = 0; w < _words; w++) M[w].store(0, std::memory_order_relaxed);
+    }
+
+    // ΪͨλͼС 2^31
+    Bitmap toBitmap() const {
+        Bitmap bitmap((int)N);
+        struct Setter {
+            Bitmap& b;
+            void operator()(size_t k) { b.set((int)k); }
+        } setter{bitmap};
+        traverse(setter);
+        return bitmap;
+    }
+};
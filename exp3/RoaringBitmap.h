@@ -0,0 +1,380 @@
+#pragma once
+
+#include <algorithm>  // Ϊʹ std::lower_bound, std::binary_search, std::min, std::fill
+#include <cstdint>    // Ϊʹ std::uint16_t, std::uint32_t, std::uint64_t
+#include <vector>     // Ϊʹ std::vector
+
+#include "Bitmap.h"
+
+// ѹλͼеһŸ 16 λͬһĵ 16 λԪضѡʽ֮һ
+//   ARRAY uint16_t 飬 ARRAY_MAX ԪأÿԪ 2 ֽ
+//   BITSET65536 λλͼ1024 ̶֣ 8 KB
+//   RUNɶÿμ (,  - 1)ÿ 4 ֽڣ runOptimize() ڸʡռʱѡ
+class RoaringContainer {
+public:
+    enum Kind { ARRAY, BITSET, RUN };
+    static constexpr int ARRAY_MAX = 4096;      // ʱ鲻λͼʡռ
+    static constexpr int BITSET_WORDS = 1024;   // 65536 / 64
+
+private:
+    Kind _kind = ARRAY;
+    int _card = 0;                        // Ԫظ
+    std::vector<std::uint16_t> _values;   // ARRAYԪأRUNΪÿε볤 - 1
+    std::vector<std::uint64_t> _bits;     // BITSET
+
+    int runs() const { return (int)_values.size() / 2; }
+
+    // RUN һ㲻 x ĶΣûʱ -1
+    int findRun(std::uint16_t x) const {
+        int lo = 0, hi = runs() - 1;
+        while (lo <= hi) {
+            int mid = (lo + hi) / 2;
+            if (_values[2 * mid] <= x) lo = mid + 1;
+            else hi = mid - 1;
+        }
+        return hi;
+    }
+
+    //  65536 λλͼԪزʱΪ
+    void assignWords(std::uint64_t const* w) {
+        _card = (int)popcountWords(w, BITSET_WORDS);
+        _values.clear();
+        _bits.clear();
+        if (_card > ARRAY_MAX) {
+            _kind = BITSET;
+            _bits.assign(w, w + BITSET_WORDS);
+        } else {
+            _kind = ARRAY;
+            _values.reserve(_card);
+            for (int i = 0; i < BITSET_WORDS; i++)
+                for (std::uint64_t bits = w[i]; bits; bits &= bits - 1)
+                    _values.push_back((std::uint16_t)(i * 64 + __builtin_ctzll(bits)));
+        }
+    }
+
+    // λͼʽȡȫԪأBITSET ֱӷݣʽչ scratch
+    std::uint64_t const* words(std::vector<std::uint64_t>& scratch) const {
+        if (_kind == BITSET) return _bits.data();
+        scratch.assign(BITSET_WORDS, 0);
+        if (_kind == ARRAY) {
+            for (std::uint16_t x : _values) scratch[x >> 6] |= (std::uint64_t)1 << (x & 63);
+        } else {  // ÿΰ䣺βȡеĲλмȫΪ 1
+            for (int r = 0; r < runs(); r++) {
+                int lo = _values[2 * r], hi = lo + _values[2 * r + 1];
+                std::uint64_t head = ~(std::uint64_t)0 << (lo & 63), tail = ~(std::uint64_t)0 >> (63 - (hi & 63));
+                if (lo >> 6 == hi >> 6) {
+                    scratch[lo >> 6] |= head & tail;
+                    continue;
+                }
+                scratch[lo >> 6] |= head;
+                std::fill(scratch.begin() + (lo >> 6) + 1, scratch.begin() + (hi >> 6), ~(std::uint64_t)0);
+                scratch[hi >> 6] |= tail;
+            }
+        }
+        return scratch.data();
+    }
+
+    // תΪ ARRAY  BITSETԱ޸
+    void unpackRuns() {
+        if (_kind != RUN) return;
+        std::vector<std::uint64_t> scratch;
+        assignWords(words(scratch));
+    }
+
+public:
+    // ԪؽԪعʱΪλͼ
+    static RoaringContainer fromArray(std::vector<std::uint16_t>&& values) {
+        RoaringContainer c;
+        c._card = (int)values.size();
+        if (c._card > ARRAY_MAX) {
+            std::vector<std::uint64_t> w(BITSET_WORDS, 0);
+            for (std::uint16_t x : values) w[x >> 6] |= (std::uint64_t)1 << (x & 63);
+            c.assignWords(w.data());
+        } else {
+            c._values = std::move(values);
+        }
+        return c;
+    }
+
+    static RoaringContainer fromWords(std::uint64_t const* w) {
+        RoaringContainer c;
+        c.assignWords(w);
+        return c;
+    }
+
+    Kind kind() const { return _kind; }
+    int count() const { return _card; }
+    bool empty() const { return _card == 0; }
+
+    // ռֽ
+    size_t bytes() const { return _values.size() * sizeof(std::uint16_t) + _bits.size() * sizeof(std::uint64_t); }
+
+    bool test(std::uint16_t x) const {
+        switch (_kind) {
+        case ARRAY: return std::binary_search(_values.begin(), _values.end(), x);
+        case BITSET: return _bits[x >> 6] >> (x & 63) & 1;
+        default: {
+            int r = findRun(x);
+            return r >= 0 && x - _values[2 * r] <= _values[2 * r + 1];
+        }
+        }
+    }
+
+    //  xǷΪԪ
+    bool set(std::uint16_t x) {
+        unpackRuns();
+        if (_kind == BITSET) {
+            std::uint64_t& w = _bits[x >> 6], bit = (std::uint64_t)1 << (x & 63);
+            if (w & bit) return false;
+            w |= bit;
+            _card++;
+            return true;
+        }
+        auto it = std::lower_bound(_values.begin(), _values.end(), x);
+        if (it != _values.end() && *it == x) return false;
+        _values.insert(it, x);
+        _card++;
+        if (_card > ARRAY_MAX) *this = fromArray(std::move(_values));
+        return true;
+    }
+
+    // ɾ x x ԭǷ
+    bool clear(std::uint16_t x) {
+        if (!test(x)) return false;
+        unpackRuns();
+        _card--;
+        if (_kind == BITSET) {
+            _bits[x >> 6] &= ~((std::uint64_t)1 << (x & 63));
+            if (_card <= ARRAY_MAX) assignWords(std::vector<std::uint64_t>(_bits).data());
+        } else {
+            _values.erase(std::lower_bound(_values.begin(), _values.end(), x));
+        }
+        return true;
+    }
+
+    // ηÿԪ high | x
+    template <typename VST>
+    void traverse(std::uint32_t high, VST&& visit) const {
+        switch (_kind) {
+        case ARRAY:
+            for (std::uint16_t x : _values) visit(high | x);
+            break;
+        case BITSET:
+            for (int i = 0; i < BITSET_WORDS; i++)
+                for (std::uint64_t bits = _bits[i]; bits; bits &= bits - 1)
+                    visit(high | (std::uint32_t)(i * 64 + __builtin_ctzll(bits)));
+            break;
+        default:
+            for (int r = 0; r < runs(); r++)
+                for (std::uint32_t x = _values[2 * r], e = x + _values[2 * r + 1]; x <= e; x++) visit(high | x);
+        }
+    }
+
+    // ʽѡʡռһ
+    void runOptimize() {
+        int n = 0;  // 
+        if (_kind == RUN) n = runs();
+        else if (_kind == ARRAY) {
+            for (int i = 0; i < _card; i++) n += i == 0 || _values[i] != _values[i - 1] + 1;
+        } else {  // ε㣺λΪ 1 ǰһλΪ 0
+            std::uint64_t prev = 0;
+            for (std::uint64_t w : _bits) {
+                n += popcount64(w & ~(w << 1 | prev >> 63));
+                prev = w;
+            }
+        }
+        size_t runBytes = 4 * (size_t)n, arrayBytes = 2 * (size_t)_card, bitsetBytes = 8 * BITSET_WORDS;
+        if (runBytes < std::min(arrayBytes, bitsetBytes)) {
+            if (_kind == RUN) return;
+            std::vector<std::uint16_t> r;
+            r.reserve(2 * n);
+            traverse(0, [&](std::uint32_t x) {
+                if (!r.empty() && r[r.size() - 2] + r.back() + 1 == (int)x) r.back()++;
+                else r.push_back((std::uint16_t)x), r.push_back(0);
+            });
+            _values.swap(r);
+            _bits.clear();
+            _bits.shrink_to_fit();
+            _kind = RUN;
+        } else {
+            unpackRuns();
+            _values.shrink_to_fit();
+        }
+    }
+
+    // a op b֮鲢ʽ롢ʱеԪأ
+    // չΪλͼ
+    template <BitOp op>
+    static RoaringContainer combined(RoaringContainer const& a, RoaringContainer const& b) {
+        if (a._kind == ARRAY && b._kind == ARRAY) {
+            std::vector<std::uint16_t> const &x = a._values, &y = b._values;
+            std::vector<std::uint16_t> r;
+            r.reserve(op == BIT_AND ? std::min(x.size(), y.size()) : op == BIT_ANDNOT ? x.size() : x.size() + y.size());
+            size_t i = 0, j = 0;
+            while (i < x.size() && j < y.size()) {
+                if (x[i] < y[j]) {
+                    if (op != BIT_AND) r.push_back(x[i]);
+                    i++;
+                } else if (y[j] < x[i]) {
+                    if (op == BIT_OR || op == BIT_XOR) r.push_back(y[j]);
+                    j++;
+                } else {
+                    if (op == BIT_AND || op == BIT_OR) r.push_back(x[i]);
+                    i++, j++;
+                }
+            }
+            if (op != BIT_AND) r.insert(r.end(), x.begin() + i, x.end());
+            if (op == BIT_OR || op == BIT_XOR) r.insert(r.end(), y.begin() + j, y.end());
+            return fromArray(std::move(r));
+        }
+        if ((op == BIT_AND || op == BIT_ANDNOT) && a._kind == ARRAY) {
+            std::vector<std::uint16_t> r;
+            for (std::uint16_t x : a._values)
+                if (b.test(x) == (op == BIT_AND)) r.push_back(x);
+            return fromArray(std::move(r));
+        }
+        if (op == BIT_AND && b._kind == ARRAY) return combined<op>(b, a);
+        std::vector<std::uint64_t> sa, sb, r(BITSET_WORDS);
+        combineWords<op>(r.data(), a.words(sa), b.words(sb), BITSET_WORDS);
+        return fromWords(r.data());
+    }
+};
+
+// ѹλͼRoaring ʽ32 λ޷ļϡ 16 λ飬ÿһ RoaringContainer
+//  16 λšռԪصĴС޹أÿÿԪ 2 ֽڣÿ̶Ŀ
+//  RoaringContainer 64 λԼ 58 ֽڣԪطɢܶ顢ÿֻмԪʱ
+// ̶ռ [0, 4 * 10^9)  10 Լ 30 ֽ/Ԫأ
+// ֻ߹е飬֮ͬ䰴ʽѡ鲢һ
+class RoaringBitmap {
+    std::vector<std::uint16_t> _keys;              // ĸ 16 λ
+    std::vector<RoaringContainer> _containers;     //  _keys һһӦΪ
+
+    //  16 λΪ key ±꣬ʱ -1
+    int find(std::uint16_t key) const {
+        auto it = std::lower_bound(_keys.begin(), _keys.end(), key);
+        return it != _keys.end() && *it == key ? (int)(it - _keys.begin()) : -1;
+    }
+
+    void append(std::uint16_t key, RoaringContainer&& c) {
+        if (c.empty()) return;
+        _keys.push_back(key);
+        _containers.push_back(std::move(c));
+    }
+
+public:
+    void set(std::uint32_t k) { //  k
+        std::uint16_t key = (std::uint16_t)(k >> 16);
+        auto it = std::lower_bound(_keys.begin(), _keys.end(), key);
+        size_t i = it - _keys.begin();
+        if (it == _keys.end() || *it != key) {
+            _keys.insert(it, key);
+            _containers.insert(_containers.begin() + i, RoaringContainer());
+        }
+        _containers[i].set((std::uint16_t)k);
+    }
+
+    void clear(std::uint32_t k) { // ɾ kյ֮ɾ
+        int i = find((std::uint16_t)(k >> 16));
+        if (i < 0 || !_containers[i].clear((std::uint16_t)k) || !_containers[i].empty()) return;
+        _keys.erase(_keys.begin() + i);
+        _containers.erase(_containers.begin() + i);
+    }
+
+    bool test(std::uint32_t k) const { //  k Ƿڼ
+        int i = find((std::uint16_t)(k >> 16));
+        return i >= 0 && _containers[i].test((std::uint16_t)k);
+    }
+
+    long long count() const { // Ԫظ
+        long long n = 0;
+        for (RoaringContainer const& c : _containers) n += c.count();
+        return n;
+    }
+
+    bool empty() const { return _keys.empty(); }
+    int containers() const { return (int)_keys.size(); }
+
+    // ռֽ
+    size_t bytes() const {
+        size_t n = _keys.size() * (sizeof(std::uint16_t) + sizeof(RoaringContainer));
+        for (RoaringContainer const& c : _containers) n += c.bytes();
+        return n;
+    }
+
+    // ʡռʽ϶ʱΪδ
+    void runOptimize() {
+        for (RoaringContainer& c : _containers) c.runOptimize();
+    }
+
+    // ÿԪ
+    template <typename VST>
+    void traverse(VST& visit) const {
+        for (size_t i = 0; i < _keys.size(); i++) _containers[i].traverse((std::uint32_t)_keys[i] << 16, visit);
+    }
+
+    // A op B 16 λ鲢ߵ
+    template <BitOp op>
+    static RoaringBitmap combined(RoaringBitmap const& A, RoaringBitmap const& B) {
+        RoaringBitmap R;
+        size_t i = 0, j = 0;
+        while (i < A._keys.size() && j < B._keys.size()) {
+            if (A._keys[i] < B._keys[j]) {
+                if (op != BIT_AND) R.append(A._keys[i], RoaringContainer(A._containers[i]));
+                i++;
+            } else if (B._keys[j] < A._keys[i]) {
+                if (op == BIT_OR || op == BIT_XOR) R.append(B._keys[j], RoaringContainer(B._containers[j]));
+                j++;
+            } else {
+                R.append(A._keys[i], RoaringContainer::combined<op>(A._containers[i], B._containers[j]));
+                i++, j++;
+            }
+        }
+        for (; op != BIT_AND && i < A._keys.size(); i++) R.append(A._keys[i], RoaringContainer(A._containers[i]));
+        for (; (op == BIT_OR || op == BIT_XOR) && j < B._keys.size(); j++)
+            R.append(B._keys[j], RoaringContainer(B._containers[j]));
+        return R;
+    }
+
+    RoaringBitmap& operator&=(RoaringBitmap const& B) { return *this = combined<BIT_AND>(*this, B); }
+    RoaringBitmap& operator|=(RoaringBitmap const& B) { return *this = combined<BIT_OR>(*this, B); }
+    RoaringBitmap& operator^=(RoaringBitmap const& B) { return *this = combined<BIT_XOR>(*this, B); }
+    RoaringBitmap& andNot(RoaringBitmap const& B) { return *this = combined<BIT_ANDNOT>(*this, B); }
+
+    // ɳλͼתÿ 65536 λ1024 ֣Ϊһ飬ȫ 0 飬ѡʡռʽ
+    static RoaringBitmap fromBitmap(Bitmap const& bitmap) {
+        RoaringBitmap R;
+        std::uint64_t const* w = bitmap.data();
+        int words = bitmap.words();
+        std::vector<std::uint64_t> last;
+        for (int lo = 0, key = 0; lo < words; lo += RoaringContainer::BITSET_WORDS, key++) {
+            std::uint64_t const* chunk = w + lo;
+            if (words - lo < RoaringContainer::BITSET_WORDS) {  // ĩβһ飬 0
+                last.assign(RoaringContainer::BITSET_WORDS, 0);
+                std::copy(w + lo, w + words, last.begin());
+                chunk = last.data();
+            }
+            RoaringContainer c = RoaringContainer::fromWords(chunk);
+            c.runOptimize();
+            R.append((std::uint16_t)key, std::move(c));
+        }
+        return R;
+    }
+
+    // תΪλͼСΪԪ + 1ԪС 2^31 - 1Bitmap  int Ϊ±꣩
+    Bitmap toBitmap() const {
+        std::uint32_t last = 0;
+        if (!empty()) _containers.back().traverse((std::uint32_t)_keys.back() << 16, [&](std::uint32_t x) { last = x; });
+        Bitmap bitmap(empty() ? 0 : (int)last + 1);
+        struct Setter {
+            Bitmap& b;
+            void operator()(std::uint32_t x) { b.set((int)x); }
+        } setter{bitmap};
+        traverse(setter);
+        return bitmap;
+    }
+};
+
+inline RoaringBitmap operator&(RoaringBitmap const& A, RoaringBitmap const& B) { return RoaringBitmap::combined<BIT_AND>(A, B); }
+inline RoaringBitmap operator|(RoaringBitmap const& A, RoaringBitmap const& B) { return RoaringBitmap::combined<BIT_OR>(A, B); }
+inline RoaringBitmap operator^(RoaringBitmap const& A, RoaringBitmap const& B) { return RoaringBitmap::combined<BIT_XOR>(A, B); }
+inline RoaringBitmap andNot(RoaringBitmap const& A, RoaringBitmap const& B) { return RoaringBitmap::combined<BIT_ANDNOT>(A, B); }
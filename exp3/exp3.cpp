@@ -6,68 +6,18 @@
 #include <cstring>
 #include <cctype>
 #include <fstream>
+#include <chrono>
+#include <iomanip>
+#include <cstdlib>
+#include <cstdint>
+#include <sstream>
+#include <thread>
+
+#include "Bitmap.h"  // λͼ Bitmapڣ3Ҫ
+#include "RoaringBitmap.h"  // ѹλͼ RoaringBitmap
+#include "ConcurrentBitmap.h"  // λͼ ConcurrentBitmap
 using namespace std;
 
-// λͼ Bitmapڣ3Ҫ
-class Bitmap {
-private:
-    unsigned char* M;
-    int N, _sz;
-
-protected:
-    void init(int n) {
-        N = n;
-        M = new unsigned char[(N + 7) / 8];  // ÿ8bitһֽ
-        memset(M, 0, (N + 7) / 8);  // ʼΪ0
-        _sz = N;
-    }
-
-public:
-    Bitmap(int n = 8) {
-        init(n);
-    } // ʼλͼС
-    ~Bitmap() {
-        delete[] M;
-    } // ͷλͼռ
-
-    void set(int k) { // õ k λΪ 1
-        if (k >= N) {
-            expand(k);
-        }
-        M[k >> 3] |= (0x80 >> (k & 0x07));  // ӦbitλΪ1
-    }
-
-    void clear(int k) { //  k λΪ 0
-        if (k >= N) {
-            expand(k);
-        }
-        M[k >> 3] &= ~(0x80 >> (k & 0x07));  // Ӧbitλ
-    }
-
-    bool test(int k) { // Ե k λǷΪ 1
-        if (k >= N) {
-            expand(k);
-        }
-        return M[k >> 3] & (0x80 >> (k & 0x07));  // bitλǷΪ1
-    }
-
-    void dump() { // λͼĶƴ
-        for (int i = 0; i < _sz; ++i) {
-            cout << (test(i) ? '1' : '0');
-        }
-        cout << endl;
-    }
-
-    void expand(int k) { // չλͼС
-        if (k < N) return;  // kСڵǰСҪչ
-        int oldN = N;
-        unsigned char* oldM = M;
-        init(2 * k);  // չ2С
-        memcpy(M, oldM, (oldN + 7) / 8);  // ƾ
-        delete[] oldM;
-    }
-};
-
 // Ľڵṹ
 struct HuffmanNode {
     char ch;
@@ -173,6 +123,144 @@ public:
     }
 };
 
+// еһ code ĵ length λдλ
+struct HuffSymbol {
+    uint64_t code;
+    int length;  // Ϊ 0 ʾַڱ
+};
+
+// λдȻ 64 λĻУ 64 λʱԸλǰ˳һд 8 ֽ
+class BitWriter {
+private:
+    vector<unsigned char>& out;
+    uint64_t acc;  //  n λΪδдλ
+    int n;
+    long long total;  // дλ
+
+    void flushWord() {
+        for (int i = 7; i >= 0; i--) out.push_back((unsigned char)(acc >> (8 * i)));
+    }
+
+public:
+    BitWriter(vector<unsigned char>& output) : out(output), acc(0), n(0), total(0) {}
+
+    // д code ĵ length λ1 <= length <= 56
+    void write(uint64_t code, int length) {
+        total += length;
+        if (n + length <= 64) {
+            acc = acc << length | code;
+            n += length;
+            return;
+        }
+        int r = 64 - n;  // ʣλд
+        acc = acc << r | code >> (length - r);
+        flushWord();
+        n = length - r;
+        acc = code & (((uint64_t)1 << n) - 1);
+    }
+
+    // дʣλĩֽڲ 8 λʱλ 0дλ
+    long long finish() {
+        for (; n >= 8; n -= 8) out.push_back((unsigned char)(acc >> (n - 8)));
+        if (n > 0) out.push_back((unsigned char)(acc << (8 - n)));
+        n = 0;
+        acc = 0;
+        return total;
+    }
+};
+
+// λĹ룺ɹֻȡַ볤ٰ (볤, ַ) ˳䷶ʽcanonical֣
+// ַΪ± 256 飬ʱ mapҲ '0'/'1' ַ
+// 볤 56볤Ϊ L ĹҪ Fibonacci(L + 2) Ƶint Ƶﲻ
+class PackedHuffCode {
+private:
+    HuffSymbol table[256];
+
+    // ¸Ҷڵȣ볤޺Ҷڵ㣬ַ '\0' Ҳɱ
+    void collectLengths(HuffmanNode* node, int depth) {
+        if (!node) return;
+        if (!node->left && !node->right) {
+            table[(unsigned char)node->ch].length = depth > 0 ? depth : 1;  // ֻһַʱ볤ȡ 1
+            return;
+        }
+        collectLengths(node->left, depth + 1);
+        collectLengths(node->right, depth + 1);
+    }
+
+public:
+    PackedHuffCode(HuffTree& tree) {
+        for (int c = 0; c < 256; c++) table[c].code = table[c].length = 0;
+        collectLengths(tree.root, 0);
+        // ʽ֣볤ַͬ߰˳ȡֵ볤ÿ 1 1 λ
+        uint64_t code = 0;
+        int length = 0;
+        for (int l = 1; l <= 56; l++)
+            for (int c = 0; c < 256; c++)
+                if (table[c].length == l) {
+                    code <<= l - length;
+                    length = l;
+                    table[c].code = code++;
+                }
+    }
+
+    const HuffSymbol& symbol(unsigned char c) const { return table[c]; }
+
+    //  text ׷ӵ outλڱеַ HuffCode::encode ͬ
+    long long encode(const string& text, vector<unsigned char>& out) const {
+        out.reserve(out.size() + text.size());
+        BitWriter writer(out);
+        for (size_t i = 0; i < text.size(); ++i) {
+            const HuffSymbol& s = table[(unsigned char)text[i]];
+            if (s.length) writer.write(s.code, s.length);
+        }
+        return writer.finish();
+    }
+
+    // ǰ bits λλ룬ÿ볤вҡ
+    // 벻ǺϷʱλ볤δƥ䣬 bits  in ĳȣشǰѽĲ
+    string decode(const vector<unsigned char>& in, long long bits) const {
+        // first[l]볤Ϊ l ĵһ֣start[l]ַ symbols еλ
+        vector<uint64_t> first(58, 0);
+        vector<int> count(58, 0), start(58, 0);
+        vector<unsigned char> symbols;
+        int maxLength = 0;
+        for (int l = 1; l <= 56; l++)
+            for (int c = 0; c < 256; c++)
+                if (table[c].length == l) {
+                    if (count[l]++ == 0) {
+                        first[l] = table[c].code;
+                        start[l] = (int)symbols.size();
+                    }
+                    symbols.push_back((unsigned char)c);
+                    maxLength = l;
+                }
+        bits = min(bits, (long long)in.size() * 8);
+        string text;
+        uint64_t code = 0;
+        int length = 0;
+        for (long long i = 0; i < bits; i++) {
+            code = code << 1 | (in[i >> 3] >> (7 - (i & 7)) & 1);
+            if (++length > maxLength) break;  // û
+            if (count[length] && code - first[length] < (uint64_t)count[length]) {
+                text += (char)symbols[start[length] + (int)(code - first[length])];
+                code = 0;
+                length = 0;
+            }
+        }
+        return text;
+    }
+
+    // ʽ
+    void printTable() const {
+        for (int c = 0; c < 256; c++)
+            if (table[c].length) {
+                cout << (char)c << ": ";
+                for (int b = table[c].length - 1; b >= 0; b--) cout << (table[c].code >> b & 1);
+                cout << endl;
+            }
+    }
+};
+
 // ȡļͳĸƵ
 string readFileContent(const string& fileName) {
     ifstream file(fileName.c_str());
@@ -189,9 +277,224 @@ string readFileContent(const string& fileName) {
     return content;
 }
 
+// λͼļrankselect /룩bits λԼ percent% Ϊ 1
+void testBitmapEfficiency(int bits, int percent, int queries) {
+    Bitmap bitmap(bits);
+    unsigned seed = 2024;
+    for (int i = 0; i < bits; i++) {
+        seed = seed * 1103515245 + 12345;
+        if ((seed >> 16) % 100 < (unsigned)percent) bitmap.set(i);
+    }
+    vector<int> ks(queries);
+    for (int i = 0; i < queries; i++) ks[i] = (int)(((long long)rand() * RAND_MAX + rand()) % bits);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    long long ones = bitmap.count();
+    double countTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    bitmap.rank(0);  // Ŀ¼
+    start = chrono::steady_clock::now();
+    long long sum = 0;
+    for (int i = 0; i < queries; i++) sum += bitmap.rank(ks[i]);
+    double rankTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // λ test()  rank Ĵֻۣѯ
+    int slow = 20;
+    start = chrono::steady_clock::now();
+    long long slowSum = 0, fastSum = 0;
+    for (int i = 0; i < slow; i++) {
+        for (int k = 0; k < ks[i]; k++) slowSum += bitmap.test(k);
+        fastSum += bitmap.rank(ks[i]);
+    }
+    double naiveTime = chrono::duration<double>(chrono::steady_clock::now() - start).count() / slow;
+
+    bool ok = slowSum == fastSum;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < queries && ones > 0; i++) {
+        long long j = ks[i] % ones;
+        int k = bitmap.select(j);
+        if (i < 1000) ok = ok && bitmap.test(k) && bitmap.rank(k) == j;
+        sum += k;
+    }
+    double selectTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    long long visited = 0;
+    struct Counter {
+        long long& n;
+        void operator()(int) { n++; }
+    } counter{visited};
+    start = chrono::steady_clock::now();
+    bitmap.traverse(counter);
+    double traverseTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << setw(10) << bits << setw(5) << percent << "%" << fixed << setprecision(2) << setw(10) << countTime * 1e3
+         << setw(12) << queries / rankTime / 1e6 << setw(12) << naiveTime * 1e3 << setw(12)
+         << queries / selectTime / 1e6 << setw(12) << visited / traverseTime / 1e6
+         << (ok && visited == ones && sum != 0 ? "" : "  MISMATCH") << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// λͼЧʣmaps  bits λλͼ &=  |= GB/sֽڼƣ
+// Լ and_count() λ test() ĺʱԱ
+void testSetAlgebraEfficiency(int bits, int maps) {
+    vector<Bitmap> bitmaps;
+    unsigned seed = 2024;
+    for (int m = 0; m < maps; m++) {
+        Bitmap b(bits);
+        for (int i = 0; i < bits; i++) {
+            seed = seed * 1103515245 + 12345;
+            if ((seed >> 16) % 100 < 90) b.set(i);  // λΪ 1ܿȫ 0
+        }
+        bitmaps.push_back(b);
+    }
+    double bytes = (double)bitmaps[0].words() * sizeof(uint64_t) * (maps - 1);
+
+    Bitmap acc = bitmaps[0];
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int m = 1; m < maps; m++) acc &= bitmaps[m];
+    double andTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    long long andOnes = acc.count();
+
+    Bitmap uni = bitmaps[0];
+    start = chrono::steady_clock::now();
+    for (int m = 1; m < maps; m++) uni |= bitmaps[m];
+    double orTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    long long fused = 0;
+    for (int m = 1; m < maps; m++) fused += bitmaps[0].and_count(bitmaps[m]);
+    double fusedTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    long long naive = 0;
+    for (int i = 0; i < bits; i++) naive += bitmaps[0].test(i) && bitmaps[1].test(i);
+    double naiveTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Ľ֮ڽ
+    bool ok = naive == bitmaps[0].and_count(bitmaps[1]) && naive == (bitmaps[0] & bitmaps[1]).count() &&
+              andOnes <= naive && uni.count() >= andOnes && fused > 0;
+    cout << setw(10) << bits << setw(6) << maps << fixed << setprecision(2) << setw(10) << bytes / andTime / 1e9
+         << setw(10) << bytes / orTime / 1e9 << setw(14) << fusedTime / (maps - 1) * 1e3 << setw(12)
+         << naiveTime * 1e3 << (ok ? "" : "  MISMATCH") << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// ѹλͼλͼıȽϣ[0, universe) ȡ ones clustered ʱΪ 1000 Σ
+// ߵֽ󽻵ĺuniverse  2^26 ʱλͼֻֽ
+void testRoaringEfficiency(long long universe, int ones, bool clustered) {
+    RoaringBitmap roaring[2];
+    unsigned seed = 2024;
+    for (int t = 0; t < 2; t++) {
+        for (int i = 0; i < ones;) {
+            seed = seed * 1103515245 + 12345;
+            long long x = ((long long)seed << 15 ^ seed >> 8) % universe;
+            for (int j = 0; j < (clustered ? 1000 : 1) && i < ones && x + j < universe; j++, i++)
+                roaring[t].set((uint32_t)(x + j));
+        }
+        roaring[t].runOptimize();
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    RoaringBitmap both = roaring[0] & roaring[1];
+    double roaringTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    double denseBytes = (double)universe / 8;
+    string denseTime = "-";
+    bool ok = true;
+    if (universe <= (1 << 26)) {
+        Bitmap dense[2] = {roaring[0].toBitmap(), roaring[1].toBitmap()};
+        start = chrono::steady_clock::now();
+        Bitmap denseBoth = dense[0] & dense[1];
+        ostringstream os;
+        os << fixed << setprecision(3) << chrono::duration<double>(chrono::steady_clock::now() - start).count() * 1e3;
+        denseTime = os.str();
+        RoaringBitmap back = RoaringBitmap::fromBitmap(denseBoth);
+        ok = denseBoth.count() == both.count() && (back ^ both).empty() && dense[0].count() == roaring[0].count();
+    }
+
+    cout << setw(12) << universe << setw(10) << ones << setw(5) << (clustered ? "run" : "rand") << fixed
+         << setprecision(1) << setw(12) << denseBytes / 1024 << setw(12) << roaring[0].bytes() / 1024.0
+         << setw(12) << denseTime << setprecision(3) << setw(12) << roaringTime * 1e3
+         << (ok ? "" : "  MISMATCH") << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// λͼĶ̱߳ǣ/룩threads ̹߳ bits Ρ
+// mode Ϊ "block" ʱ̱߳ǸһΣãΪ "stride" ʱ߳ t  t, t + threads, ...
+// ֣߳ͬΪ "random" ʱǣظλ test_and_set() ķֵʶ
+void testConcurrentMarking(int bits, int threads, string const& mode) {
+    ConcurrentBitmap bitmap(bits);
+    vector<long long> first(threads, 0);  // ߳״αǳɹĴ
+    bool stride = mode == "stride", random = mode == "random";
+    vector<thread> workers;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++)
+        workers.emplace_back([&, t] {
+            long long n = 0;
+            int lo = (int)((long long)bits * t / threads), hi = (int)((long long)bits * (t + 1) / threads);
+            unsigned seed = 2024 + t;
+            for (int i = lo; i < hi; i++) {
+                int k = i;
+                if (stride) k = (i - lo) * threads + t < bits ? (i - lo) * threads + t : i;
+                else if (random) k = (int)(((seed = seed * 1103515245 + 12345) >> 4) % (unsigned)bits);  // λڶ̣ȥ
+                n += !bitmap.test_and_set(k);
+            }
+            first[t] = n;
+        });
+    for (thread& w : workers) w.join();
+    double time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    long long marked = 0;
+    for (long long n : first) marked += n;
+    bool ok = marked == bitmap.count() && (random || marked == bits);
+    cout << setw(10) << bits << setw(9) << threads << setw(8) << mode << fixed << setprecision(2) << setw(12)
+         << bits / time / 1e6 << setw(12) << marked << (ok ? "" : "  MISMATCH") << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// ļıMB/sСļַƵʽļظ minBytes ֽڡ
+// Ա HuffCode::encode()  '0'/'1' ַλ Bitmap PackedHuffCode ֱдֽ
+void testHuffmanThroughput(const string& text, size_t minBytes) {
+    string input = text;
+    while (input.size() < minBytes) input += text;
+
+    map<char, int> freqMap;
+    for (size_t i = 0; i < text.size(); ++i) freqMap[text[i]]++;
+    HuffTree huffTree(freqMap);
+    HuffCode huffCode(huffTree);
+    PackedHuffCode packed(huffTree);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    string encodedStr = huffCode.encode(input);
+    Bitmap bitmap((int)encodedStr.size());
+    for (size_t i = 0; i < encodedStr.size(); ++i)
+        if (encodedStr[i] == '1') bitmap.set((int)i);
+    double stringTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    vector<unsigned char> out;
+    start = chrono::steady_clock::now();
+    long long bits = packed.encode(input, out);
+    double packedTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // 볤ͬλӦһ£һԭĺ˶
+    vector<unsigned char> once;
+    long long onceBits = packed.encode(text, once);
+    bool ok = bits == (long long)encodedStr.size() && packed.decode(once, onceBits) == text;
+    double mb = input.size() / 1e6;
+    cout << setw(12) << input.size() << fixed << setprecision(1) << setw(12) << mb / stringTime << setw(12)
+         << mb / packedTime << setw(14) << encodedStr.size() << setw(14) << out.size() << setprecision(3)
+         << setw(8) << (double)bits / input.size() << (ok ? "" : "  MISMATCH") << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
 // ʵֹ㷨Եʽб룬ڣ4Ҫ
-int main() {
-    string fileName = "D:\\I have a dream.txt";  // ļΪ I_have_a_dream.txt
+int main(int argc, char* argv[]) {
+    string fileName = argc > 1 ? argv[1] : "D:\\I have a dream.txt";  // ļΪ I_have_a_dream.txtҲָ
     string inputText = readFileContent(fileName);  // ȡļ
 
     if (inputText.empty()) {
@@ -251,6 +554,61 @@ int main() {
     cout << "Bitmap representation of '" << word << "': ";
     bitmap.dump();
 
+    // λķʽ룺ϱ볤ְͬ (볤, ĸ) ·
+    cout << "\nCanonical Huffman Code Table:" << endl;
+    PackedHuffCode packedCode(huffTree);
+    packedCode.printTable();
+    const char* words[] = {"dream", "freedom"};
+    for (int w = 0; w < 2; w++) {
+        vector<unsigned char> packedBytes;
+        long long bits = packedCode.encode(words[w], packedBytes);
+        cout << "Packed '" << words[w] << "': " << bits << " bits," << hex << setfill('0');
+        for (size_t i = 0; i < packedBytes.size(); ++i) cout << " " << setw(2) << (int)packedBytes[i];
+        cout << dec << setfill(' ') << endl;
+    }
+
+    // ļı룺ַַʽ MB/sֽƽÿַλ
+    cout << "\n" << setw(12) << "bytes" << setw(12) << "string MB/s" << setw(12) << "packed MB/s" << setw(14)
+         << "string bytes" << setw(14) << "packed bytes" << setw(8) << "bits/ch" << endl;
+    testHuffmanThroughput(inputText, 1 << 24);
+
+    // λͼЧʲԣcount λ test() һ rank ĺrankselect İ/룬İ 1/
+    cout << "\n" << setw(10) << "bits" << setw(6) << "ones" << setw(10) << "count ms" << setw(12) << "rank"
+         << setw(12) << "naive ms" << setw(12) << "select" << setw(12) << "traverse" << endl;
+    testBitmapEfficiency(1 << 26, 50, 10000000);
+    testBitmapEfficiency(1 << 26, 1, 10000000);
+
+    // 㣺&=|=  GB/sand_count λ test() һεĺ
+    cout << "\n" << setw(10) << "bits" << setw(6) << "maps" << setw(10) << "and GB/s" << setw(10) << "or GB/s"
+         << setw(14) << "and_count ms" << setw(12) << "naive ms" << endl;
+    testSetAlgebraEfficiency(1 << 24, 32);
+
+    // ѹλͼλͼѹλͼ KB 󽻵ĺ
+    cout << "\n" << setw(12) << "universe" << setw(10) << "ones" << setw(5) << "" << setw(12) << "dense KB"
+         << setw(12) << "roaring KB" << setw(12) << "dense ms" << setw(12) << "roaring ms" << endl;
+    testRoaringEfficiency(1 << 26, 100000, false);
+    testRoaringEfficiency(1 << 26, 1000000, true);
+    testRoaringEfficiency(1 << 26, 20000000, false);
+    testRoaringEfficiency(4000000000LL, 100000, false);
+
+    // λͼǵİ/룬״αǳɹĴ߳ͨλͼΪ
+    cout << "\n" << setw(10) << "bits" << setw(9) << "threads" << setw(8) << "mode" << setw(12) << "Mops/s"
+         << setw(12) << "marked" << endl;
+    {
+        int bits = 1 << 24;
+        Bitmap plain(bits);
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int i = 0; i < bits; i++) plain.set(i);
+        double time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << setw(10) << bits << setw(9) << 1 << setw(8) << "plain" << fixed << setprecision(2) << setw(12)
+             << bits / time / 1e6 << setw(12) << plain.count() << endl;
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+        int hw = max(1, (int)thread::hardware_concurrency());
+        for (int threads = 1; threads <= max(4, hw); threads *= 2)
+            for (string mode : {"block", "stride", "random"}) testConcurrentMarking(bits, threads, mode);
+    }
+
     return 0;
 }
 